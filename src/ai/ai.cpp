@@ -19,10 +19,32 @@
 
 namespace ai {
 
+inline bool get_cached_potential(sys::state& state, dcon::decision_id d, dcon::nation_id n) {
+	auto word = state.decision_potential_cache[size_t(d.index()) * state.decision_potential_cache_stride + n.index() / 64];
+	return ((word >> (n.index() & 63)) & 1) != 0;
+}
+inline void set_cached_potential(sys::state& state, dcon::decision_id d, dcon::nation_id n, bool value) {
+	auto& word = state.decision_potential_cache[size_t(d.index()) * state.decision_potential_cache_stride + n.index() / 64];
+	auto bit = uint64_t(1) << (n.index() & 63);
+	word = value ? (word | bit) : (word & ~bit);
+}
+
 void take_ai_decisions(sys::state& state) {
 	using decision_nation_pair = std::pair<dcon::decision_id, dcon::nation_id>;
 	concurrency::combinable<std::vector<decision_nation_pair, dcon::cache_aligned_allocator<decision_nation_pair>>> decisions_taken;
 
+	// cached potential results are kept per nation slot, so start over if new slots were added
+	if(state.decision_potential_cache_stride * 64 < state.world.nation_size()) {
+		state.decision_potential_cache_stride = (state.world.nation_size() + 63) / 64;
+		state.decision_potential_cache.assign(size_t(state.world.decision_size()) * state.decision_potential_cache_stride, 0);
+		state.decision_potential_cache_valid.assign(state.world.decision_size(), 0);
+	}
+	if(state.national_definitions.global_flags_changed) {
+		for(auto n : state.world.in_nation)
+			trigger::mark_inputs_changed(state, n, trigger::inputs::global_flags);
+		state.national_definitions.global_flags_changed = false;
+	}
+
 	// execute in staggered blocks
 	uint32_t d_block_size = state.world.decision_size() / 32;
 	uint32_t block_index = 0;
@@ -36,15 +58,54 @@ void take_ai_decisions(sys::state& state) {
 			auto potential = state.world.decision_get_potential(d);
 			auto allow = state.world.decision_get_allow(d);
 			auto ai_will_do = state.world.decision_get_ai_will_do(d);
+			auto const& filter = state.decision_prefilters[d];
+			if(!trigger::prefilter_passes_globally(state, filter)) {
+				state.decision_potential_cache_valid[i] = 0;
+				return;
+			}
+			if(trigger::prefilter_limits_candidates(filter)) {
+				state.decision_potential_cache_valid[i] = 0;
+				// at most one nation can pass potential and allow, so test only that one
+				auto n = trigger::prefilter_candidate(state, filter);
+				if(n && !state.world.nation_get_is_player_controlled(n)
+					&& state.world.nation_get_owned_province_count(n) != 0
+					&& (!potential || trigger::evaluate(state, potential, trigger::to_generic(n), trigger::to_generic(n), 0))
+					&& (!allow || trigger::evaluate(state, allow, trigger::to_generic(n), trigger::to_generic(n), 0))
+					&& (!ai_will_do || trigger::evaluate_multiplicative_modifier(state, ai_will_do, trigger::to_generic(n), trigger::to_generic(n), 0) > 0.0f)) {
+					decisions_taken.local().push_back(decision_nation_pair(d, n));
+				}
+				return;
+			}
+			// potential triggers that only read tracked inputs are re-evaluated only for nations where one of those inputs changed
+			auto potential_inputs = state.decision_potential_inputs[d];
+			bool use_cache = potential && (potential_inputs & trigger::inputs::untracked) == 0;
+			bool cache_valid = use_cache && state.decision_potential_cache_valid[i] != 0;
 			ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto ids) {
 				// AI-only, not dead nations
 				ve::mask_vector filter_a = !state.world.nation_get_is_player_controlled(ids)
 					&& state.world.nation_get_owned_province_count(ids) != 0;
 				if(ve::compress_mask(filter_a).v != 0) {
 					// empty allow assumed to be an "always = yes"
-					ve::mask_vector filter_b = potential
-						? filter_a && (trigger::evaluate(state, potential, trigger::to_generic(ids), trigger::to_generic(ids), 0))
-						: filter_a;
+					ve::mask_vector filter_b = filter_a;
+					if(use_cache) {
+						ve::mask_vector dirty = filter_a && ve::apply([&](dcon::nation_id n) {
+							return !cache_valid || (~state.world.nation_get_clean_trigger_inputs(n) & potential_inputs) != 0;
+						}, ids);
+						ve::mask_vector fresh = ve::compress_mask(dirty).v != 0
+							? trigger::evaluate(state, potential, trigger::to_generic(ids), trigger::to_generic(ids), 0)
+							: ve::mask_vector{ false };
+						filter_b = filter_a && ve::apply([&](dcon::nation_id n, bool is_dirty, bool is_valid, bool value) {
+							if(!is_valid)
+								return false;
+							if(is_dirty) {
+								set_cached_potential(state, d, n, value);
+								return value;
+							}
+							return get_cached_potential(state, d, n);
+						}, ids, dirty, filter_a, fresh);
+					} else if(potential) {
+						filter_b = filter_a && (trigger::evaluate(state, potential, trigger::to_generic(ids), trigger::to_generic(ids), 0));
+					}
 					if(ve::compress_mask(filter_b).v != 0) {
 						ve::mask_vector filter_c = allow
 							? filter_b && (trigger::evaluate(state, allow, trigger::to_generic(ids), trigger::to_generic(ids), 0))
@@ -62,8 +123,18 @@ void take_ai_decisions(sys::state& state) {
 					}
 				}
 			});
+			if(use_cache)
+				state.decision_potential_cache_valid[i] = 1;
 		}
 	});
+	// every active AI nation has now been evaluated against its current inputs
+	// the others were skipped and their cached results may be out of date when they are next evaluated
+	for(auto n : state.world.in_nation) {
+		if(!n.get_is_player_controlled() && n.get_owned_province_count() != 0)
+			n.set_clean_trigger_inputs(trigger::inputs::all);
+		else
+			n.set_clean_trigger_inputs(0);
+	}
 	// combination and final execution
 	auto total_vector = decisions_taken.combine([](auto& a, auto& b) {
 		std::vector<decision_nation_pair, dcon::cache_aligned_allocator<decision_nation_pair>> result(a.begin(), a.end());
@@ -1460,13 +1531,59 @@ float estimate_enemy_defensive_force(sys::state& state, dcon::province_id target
 	return state.defines.alice_ai_offensive_strength_overestimate * strength_total;
 }
 
-void assign_targets(sys::state& state, dcon::nation_id n) {
+// army moves chosen by assign_targets for one nation, applied after all nations have been processed
+// paths are stored back to back in a single buffer that keeps its capacity between runs
+struct army_orders {
+	struct move {
+		dcon::army_id army;
+		uint32_t path_start = 0;
+		uint32_t path_size = 0;
+	};
+	std::vector<move> moves;
+	std::vector<dcon::province_id> paths;
+
+	void clear() {
+		moves.clear();
+		paths.clear();
+	}
+};
+
+inline bool test_and_set_bit(std::vector<uint64_t>& bits, uint32_t index) {
+	auto& word = bits[index / 64];
+	auto bit = uint64_t(1) << (index & 63);
+	bool was_set = (word & bit) != 0;
+	word |= bit;
+	return was_set;
+}
+inline void clear_bit(std::vector<uint64_t>& bits, uint32_t index) {
+	bits[index / 64] &= ~(uint64_t(1) << (index & 63));
+}
+
+void assign_targets(sys::state& state, dcon::nation_id n, army_orders& orders) {
 	struct a_str {
 		dcon::province_id p;
 		float str = 0.0f;
+		float dist = 0.0f;
+	};
+	struct army_target {
+		float minimal_distance;
+		dcon::province_id location;
+		float strength_estimate = 0.0f;
 	};
-	std::vector<a_str> ready_armies;
-	ready_armies.reserve(state.world.province_size());
+	// scratch space, reused by every nation processed on the same thread
+	// the bitsets are always left cleared
+	static thread_local std::vector<a_str> ready_armies;
+	static thread_local std::vector<army_target> potential_targets;
+	static thread_local std::vector<dcon::nation_id> at_war_with;
+	static thread_local std::vector<uint64_t> seen_provinces;
+	static thread_local std::vector<uint64_t> seen_nations;
+	ready_armies.clear();
+	potential_targets.clear();
+	at_war_with.clear();
+	if(seen_provinces.size() * 64 < state.world.province_size())
+		seen_provinces.resize((state.world.province_size() + 63) / 64, 0);
+	if(seen_nations.size() * 64 < state.world.nation_size())
+		seen_nations.resize((state.world.nation_size() + 63) / 64, 0);
 
 	int32_t ready_count = 0;
 	for(auto ar : state.world.nation_get_army_control(n)) {
@@ -1483,23 +1600,17 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 
 		++ready_count;
 		auto loc = ar.get_army().get_location_from_army_location().id;
-		if(std::find_if(ready_armies.begin(), ready_armies.end(), [loc](a_str const& v) { return loc == v.p; }) == ready_armies.end()) {
+		if(!test_and_set_bit(seen_provinces, loc.index())) {
 			ready_armies.push_back(a_str{ loc, 0.0f });
 		}
 	}
+	for(auto const& r : ready_armies)
+		clear_bit(seen_provinces, r.p.index());
 
 	if(ready_armies.empty())
 		return; // nothing to attack with
 
-	struct army_target {
-		float minimal_distance;
-		dcon::province_id location;
-		float strength_estimate = 0.0f;
-	};
-
 	/* Ourselves */
-	std::vector<army_target> potential_targets;
-	potential_targets.reserve(state.world.province_size());
 	for(auto o : state.world.nation_get_province_ownership(n)) {
 		if(!o.get_province().get_nation_from_province_control()
 			|| military::rebel_army_in_province(state, o.get_province())
@@ -1510,18 +1621,18 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 		}
 	}
 	/* Nations we're at war with OR hostile to */
-	std::vector<dcon::nation_id> at_war_with;
-	at_war_with.reserve(state.world.nation_size());
 	for(auto w : state.world.nation_get_war_participant(n)) {
 		auto attacker = w.get_is_attacker();
 		for(auto p : w.get_war().get_war_participant()) {
 			if(p.get_is_attacker() != attacker) {
-				if(std::find(at_war_with.begin(), at_war_with.end(), p.get_nation().id) == at_war_with.end()) {
+				if(!test_and_set_bit(seen_nations, p.get_nation().id.index())) {
 					at_war_with.push_back(p.get_nation().id);
 				}
 			}
 		}
 	}
+	for(auto w : at_war_with)
+		clear_bit(seen_nations, w.index());
 	for(auto w : at_war_with) {
 		for(auto o : state.world.nation_get_province_control(w)) {
 			potential_targets.push_back(
@@ -1578,11 +1689,11 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 			potential_targets[i].strength_estimate = estimate_enemy_defensive_force(state, potential_targets[i].location, n) + 0.00001f;
 
 		auto target_attack_force = potential_targets[i].strength_estimate;
+		for(auto& r : ready_armies)
+			r.dist = province::sorting_distance(state, r.p, potential_targets[i].location);
 		std::sort(ready_armies.begin(), ready_armies.end(), [&](a_str const& a, a_str const& b) {
-			auto adist = province::sorting_distance(state, a.p, potential_targets[i].location);
-			auto bdist = province::sorting_distance(state, b.p, potential_targets[i].location);
-			if(adist != bdist)
-				return adist > bdist;
+			if(a.dist != b.dist)
+				return a.dist > b.dist;
 			else
 				return a.p.index() < b.p.index();
 		});
@@ -1659,7 +1770,9 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 					ar.get_army().set_ai_province(potential_targets[i].location);
 					ar.get_army().set_ai_activity(uint8_t(army_activity::attacking));
 				} else if(auto path = province::make_safe_land_path(state, ready_armies[m].p, central_province, n); !path.empty()) {
-					military::move_army_fast(state, ar.get_army(), path, n);
+					// changing the path of an army is not thread safe, so the move is issued later
+					orders.moves.push_back(army_orders::move{ ar.get_army().id, uint32_t(orders.paths.size()), uint32_t(path.size()) });
+					orders.paths.insert(orders.paths.end(), path.begin(), path.end());
 					ar.get_army().set_ai_province(potential_targets[i].location);
 					ar.get_army().set_ai_activity(uint8_t(army_activity::attacking));
 				}
@@ -1680,12 +1793,26 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 }
 
 void make_attacks(sys::state& state) {
+	static std::vector<army_orders> orders;
+	if(orders.size() < state.world.nation_size())
+		orders.resize(state.world.nation_size());
+
 	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
 		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		orders[i].clear();
 		if(state.world.nation_is_valid(n)) {
-			assign_targets(state, n);
+			assign_targets(state, n, orders[i]);
 		}
 	});
+
+	// issue the moves in nation order so that the result does not depend on scheduling
+	for(uint32_t i = 0; i < state.world.nation_size(); ++i) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		auto& o = orders[i];
+		for(auto const& m : o.moves) {
+			military::move_army_fast(state, m.army, std::span<dcon::province_id>(o.paths.data() + m.path_start, m.path_size), n);
+		}
+	}
 }
 
 void make_defense(sys::state& state) {
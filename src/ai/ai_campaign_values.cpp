@@ -131,6 +131,19 @@ float estimate_additional_offensive_strength(sys::state& state, dcon::nation_id
 	return value * state.defines.alice_ai_offensive_strength_overestimate;
 }
 
+float estimate_max_additional_offensive_strength(sys::state& state, dcon::nation_id n) {
+	float value = 0.f;
+	for(auto dr : state.world.nation_get_diplomatic_relation(n)) {
+		if(!dr.get_are_allied())
+			continue;
+
+		auto other = dr.get_related_nations(0) != n ? dr.get_related_nations(0) : dr.get_related_nations(1);
+		if(other.get_overlord_as_subject().get_ruler() != n)
+			value += estimate_strength(state, other);
+	}
+	return value * state.defines.alice_ai_offensive_strength_overestimate;
+}
+
 float estimate_naval_strength(sys::state& state, dcon::nation_id n) {
 	return (float)state.world.nation_get_used_naval_supply_points(n);
 }
@@ -18,6 +18,8 @@ float estimate_naval_strength(sys::state& state, dcon::nation_id n);
 float estimate_strength(sys::state& state, dcon::nation_id n);
 float estimate_defensive_strength(sys::state& state, dcon::nation_id n);
 float estimate_additional_offensive_strength(sys::state& state, dcon::nation_id n, dcon::nation_id target);
+// upper bound of estimate_additional_offensive_strength over all targets
+float estimate_max_additional_offensive_strength(sys::state& state, dcon::nation_id n);
 
 bool does_have_naval_supremacy(sys::state& state, dcon::nation_id n, dcon::nation_id target);
 
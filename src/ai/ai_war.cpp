@@ -2034,9 +2034,19 @@ void make_war_decs(sys::state& state) {
 		if(state.world.nation_get_war_exhaustion(n) > state.defines.alice_ai_war_exhaustion_readiness_limit)
 			return;
 		auto base_strength = estimate_strength(state, n);
+		// no target can be better than this against its defensive strength, so hopeless targets are rejected before the cb checks
+		auto max_offensive_strength = base_strength + estimate_max_additional_offensive_strength(state, n);
 		float best_difference = 2.0f;
 		//Great powers should look for non-neighbor nations to use their existing wargoals on; helpful for forcing unification/repay debts wars to happen
 		if(nations::is_great_power(state, n)) {
+			// sphere members that can be reached from our capital over land, found with one flood fill instead of a path per neighbor
+			std::vector<uint8_t> reachable_provinces;
+			province::mark_safe_land_reachable(state, state.world.nation_get_capital(n), n, reachable_provinces);
+			std::vector<uint8_t> reachable_sphere(state.world.nation_size(), 0);
+			for(auto other : state.world.in_nation) {
+				if(other.get_in_sphere_of() == n && other.get_capital() && reachable_provinces[other.get_capital().id.index()] != 0)
+					reachable_sphere[other.id.index()] = 1;
+			}
 			for(auto target : state.world.in_nation) {
 				auto real_target = target.get_overlord_as_subject().get_ruler() ? target.get_overlord_as_subject().get_ruler() : target;
 				if(target == n || real_target == n)
@@ -2049,29 +2059,24 @@ void make_war_decs(sys::state& state) {
 					continue;
 				if(military::has_truce_with(state, n, real_target))
 					continue;
+				auto defensive_strength = estimate_defensive_strength(state, real_target);
+				if(max_offensive_strength - defensive_strength <= best_difference)
+					continue;
 				if(!military::can_use_cb_against(state, n, target))
 					continue;
 				//If it neighbors one of our spheres and we can pathfind to each other's capitals, we don't need naval supremacy to reach this nation
 				//Generally here to help Prussia realize it doesn't need a navy to attack Denmark
+				bool reachable_by_land = false;
 				for(auto adj : state.world.nation_get_nation_adjacency(target)) {
 					auto other = adj.get_connected_nations(0) != n ? adj.get_connected_nations(0) : adj.get_connected_nations(1);
-					auto neighbor = other;
-					if(neighbor.get_in_sphere_of() == n) {
-						auto path = province::make_safe_land_path(state, state.world.nation_get_capital(n), state.world.nation_get_capital(neighbor), n);
-						if(path.empty()) {
-							continue;
-						}
-						auto str_difference = base_strength + estimate_additional_offensive_strength(state, n, real_target) - estimate_defensive_strength(state, real_target);
-						if(str_difference > best_difference) {
-							best_difference = str_difference;
-							targets.set(n, target.id);
-							break;
-						}
+					if(reachable_sphere[other.id.index()] != 0) {
+						reachable_by_land = true;
+						break;
 					}
 				}
-				if(!state.world.get_nation_adjacency_by_nation_adjacency_pair(n, target) && !does_have_naval_supremacy(state, n, target))
+				if(!reachable_by_land && !state.world.get_nation_adjacency_by_nation_adjacency_pair(n, target) && !does_have_naval_supremacy(state, n, target))
 					continue;
-				auto str_difference = base_strength + estimate_additional_offensive_strength(state, n, real_target) - estimate_defensive_strength(state, real_target);
+				auto str_difference = base_strength + estimate_additional_offensive_strength(state, n, real_target) - defensive_strength;
 				if(str_difference > best_difference) {
 					best_difference = str_difference;
 					targets.set(n, target.id);
@@ -2091,11 +2096,14 @@ void make_war_decs(sys::state& state) {
 				continue;
 			if(military::has_truce_with(state, n, other) || military::has_truce_with(state, n, real_target))
 				continue;
+			auto defensive_strength = estimate_defensive_strength(state, real_target);
+			if(max_offensive_strength - defensive_strength <= best_difference)
+				continue;
 			if(!military::can_use_cb_against(state, n, other))
 				continue;
 			if(!state.world.get_nation_adjacency_by_nation_adjacency_pair(n, other) && !does_have_naval_supremacy(state, n, other))
 				continue;
-			auto str_difference = base_strength + estimate_additional_offensive_strength(state, n, real_target) - estimate_defensive_strength(state, real_target);
+			auto str_difference = base_strength + estimate_additional_offensive_strength(state, n, real_target) - defensive_strength;
 			if(str_difference > best_difference) {
 				best_difference = str_difference;
 				targets.set(n, other.id);
@@ -2122,11 +2130,14 @@ void make_war_decs(sys::state& state) {
 					continue;
 				if(military::has_truce_with(state, n, other) || military::has_truce_with(state, n, real_target))
 					continue;
+				auto defensive_strength = estimate_defensive_strength(state, real_target);
+				if(max_offensive_strength - defensive_strength <= best_difference)
+					continue;
 				if(!military::can_use_cb_against(state, n, other))
 					continue;
 				if(!state.world.get_nation_adjacency_by_nation_adjacency_pair(n, other) && !does_have_naval_supremacy(state, n, other))
 					continue;
-				auto str_difference = base_strength + estimate_additional_offensive_strength(state, n, real_target) - estimate_defensive_strength(state, real_target);
+				auto str_difference = base_strength + estimate_additional_offensive_strength(state, n, real_target) - defensive_strength;
 				if(str_difference > best_difference) {
 					best_difference = str_difference;
 					targets.set(n, other);
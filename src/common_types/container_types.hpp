@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <limits>
 #include "dcon_generated.hpp"
 
 namespace sys {
@@ -122,6 +123,16 @@ static_assert(sizeof(event_option) ==
 	+ sizeof(event_option::ai_chance)
 	+ sizeof(event_option::effect));
 
+// cheap necessary conditions lifted out of the top level of a trigger
+// if any of them fails, the trigger as a whole is known to be false
+struct trigger_prefilter {
+	dcon::national_identity_id tag; // tag = X
+	dcon::national_identity_id existing_tag; // exists = X
+	dcon::province_id owned_province; // owns = N
+	int32_t min_year = std::numeric_limits<int32_t>::min();
+	int32_t max_year = std::numeric_limits<int32_t>::max();
+};
+
 struct modifier_hash {
 	using is_avalanching = void;
 
@@ -276,7 +287,7 @@ struct checksum_key {
 	static constexpr uint32_t key_size = 64;
 	uint8_t key[key_size] = { 0 };
 
-	bool is_equal(const checksum_key& a) noexcept {
+	bool is_equal(const checksum_key& a) const noexcept {
 		for(size_t i = 0; i < key_size; i++)
 			if(key[i] != a.key[i])
 				return false;
@@ -427,6 +427,7 @@ void apply_technology(sys::state& state, dcon::nation_id target_nation, dcon::te
 	auto tech_id = fatten(state.world, t_id);
 
 	state.world.nation_set_active_technologies(target_nation, t_id, true);
+	trigger::mark_inputs_changed(state, target_nation, trigger::inputs::technology);
 
 	auto tech_mod = tech_id.get_modifier();
 	if(tech_mod) {
@@ -508,6 +509,7 @@ void remove_technology(sys::state& state, dcon::nation_id target_nation, dcon::t
 	auto tech_id = fatten(state.world, t_id);
 
 	state.world.nation_set_active_technologies(target_nation, t_id, false);
+	trigger::mark_inputs_changed(state, target_nation, trigger::inputs::technology);
 
 	auto tech_mod = tech_id.get_modifier();
 	if(tech_mod) {
@@ -588,6 +590,7 @@ void apply_invention(sys::state& state, dcon::nation_id target_nation, dcon::inv
 	auto inv_id = fatten(state.world, i_id);
 
 	state.world.nation_set_active_inventions(target_nation, i_id, true);
+	trigger::mark_inputs_changed(state, target_nation, trigger::inputs::technology);
 
 	// apply modifiers from active inventions
 	auto inv_mod = inv_id.get_modifier();
@@ -708,6 +711,7 @@ void remove_invention(sys::state& state, dcon::nation_id target_nation,
 	auto inv_id = fatten(state.world, i_id);
 
 	state.world.nation_set_active_inventions(target_nation, i_id, false);
+	trigger::mark_inputs_changed(state, target_nation, trigger::inputs::technology);
 
 	// apply modifiers from active inventions
 	auto inv_mod = inv_id.get_modifier();
@@ -874,6 +878,7 @@ void fix_slaves_in_province(sys::state& state, dcon::nation_id owner, dcon::prov
 }
 
 void update_nation_issue_rules(sys::state& state, dcon::nation_id n_id) {
+	trigger::mark_inputs_changed(state, n_id, trigger::inputs::politics);
 	auto old_rules = state.world.nation_get_combined_issue_rules(n_id);
 	uint32_t combined = 0;
 	state.world.for_each_issue([&](dcon::issue_id i_id) {
@@ -435,6 +435,7 @@ void update_displayed_identity(sys::state& state, dcon::nation_id id) {
 	} else {
 		state.world.nation_set_color(id, state.world.national_identity_get_color(ident));
 	}
+	trigger::mark_inputs_changed(state, id, trigger::inputs::ownership);
 	state.province_ownership_changed.store(true, std::memory_order::release);
 }
 
@@ -443,6 +444,7 @@ void change_government_type(sys::state& state, dcon::nation_id n, dcon::governme
 	if(old_gov != new_type) {
 		assert(state.world.government_type_is_valid(new_type));
 		state.world.nation_set_government_type(n, new_type);
+		trigger::mark_inputs_changed(state, n, trigger::inputs::politics);
 
 		if((state.world.government_type_get_ideologies_allowed(new_type) & culture::to_bits(state.world.nation_get_ruling_party(n).get_ideology())) == 0) {
 
@@ -997,6 +999,7 @@ void set_issue_option(sys::state& state, dcon::nation_id n, dcon::issue_option_i
 			uint32_t((opt.index() << 2) ^ n.index()));
 	}
 	state.world.nation_set_issues(n, parent, opt);
+	trigger::mark_inputs_changed(state, n, trigger::inputs::politics);
 }
 void set_reform_option(sys::state& state, dcon::nation_id n, dcon::reform_option_id opt) {
 	auto parent = state.world.reform_option_get_parent_reform(opt);
@@ -1007,6 +1010,7 @@ void set_reform_option(sys::state& state, dcon::nation_id n, dcon::reform_option
 			uint32_t((opt.index() << 2) ^ n.index()));
 	}
 	state.world.nation_set_reforms(n, parent, opt);
+	trigger::mark_inputs_changed(state, n, trigger::inputs::politics);
 }
 
 } // namespace politics
@@ -13,6 +13,14 @@ ve::mask_vector inline valid_need(sys::state& state, T n, dcon::commodity_id c)
 	return available_at_start || active_mask;
 }
 
+// each pop type needs only a handful of commodities: the kernels over (pop type, commodity) pairs skip the pairs without
+// base needs, whose contribution is zero anyway
+bool inline pop_type_needs_commodity(sys::state& state, dcon::pop_type_id t, dcon::commodity_id c) {
+	return state.world.pop_type_get_life_needs(t, c) != 0.f
+		|| state.world.pop_type_get_everyday_needs(t, c) != 0.f
+		|| state.world.pop_type_get_luxury_needs(t, c) != 0.f;
+}
+
 bool inline valid_life_need(sys::state& state, dcon::nation_id n, dcon::commodity_id c) {
 	return state.world.commodity_get_is_life_need(c) && valid_need(state, n, c);
 }
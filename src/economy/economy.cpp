@@ -377,17 +377,64 @@ void convert_commodities_into_ingredients(
 	});
 }
 
+// largest change of market prices (relative) and of labor demand satisfaction (absolute) since the last call,
+// the current values are kept for the next one
+inline float presimulation_change(sys::state& state, std::vector<float>& last_prices, std::vector<float>& last_employment) {
+	auto const total_commodities = state.world.commodity_size();
+	auto const total_markets = state.world.market_size();
+	auto const total_provinces = state.world.province_size();
+
+	bool first = last_prices.empty();
+	last_prices.resize(size_t(total_markets) * total_commodities, 0.f);
+	last_employment.resize(size_t(total_provinces) * labor::total, 0.f);
+
+	float max_change = 0.f;
+	for(uint32_t m = 0; m < total_markets; ++m) {
+		dcon::market_id mid{ dcon::market_id::value_base_t(m) };
+		for(uint32_t c = 1; c < total_commodities; ++c) {
+			dcon::commodity_id cid{ dcon::commodity_id::value_base_t(c) };
+			auto& last = last_prices[size_t(m) * total_commodities + c];
+			auto current = state.world.market_get_price(mid, cid);
+			max_change = std::max(max_change, std::abs(current - last) / std::max(std::abs(last), 0.01f));
+			last = current;
+		}
+	}
+	for(uint32_t p = 0; p < total_provinces; ++p) {
+		dcon::province_id pid{ dcon::province_id::value_base_t(p) };
+		for(int32_t i = 0; i < labor::total; ++i) {
+			auto& last = last_employment[size_t(p) * labor::total + i];
+			auto current = state.world.province_get_labor_demand_satisfaction(pid, i);
+			max_change = std::max(max_change, std::abs(current - last));
+			last = current;
+		}
+	}
+	return first ? std::numeric_limits<float>::infinity() : max_change;
+}
+
 void presimulate(sys::state& state) {
 	// economic updates without construction
+	// stops early once prices and employment settle: the result is stored in the scenario, so this only affects building it
 #ifdef NDEBUG
 	uint32_t steps = 10;
+	uint32_t min_steps = 3;
 #else
 	uint32_t steps = 2;
+	uint32_t min_steps = 2;
 #endif
+	constexpr float settled_change = 0.001f;
+
+	std::vector<float> last_prices;
+	std::vector<float> last_employment;
+	presimulation_change(state, last_prices, last_employment);
+
 	for(uint32_t i = 0; i < steps; i++) {
 		update_employment(state);
 		daily_update(state, true, (float)i / (float)steps);
 		ai::update_budget(state);
+
+		if(presimulation_change(state, last_prices, last_employment) < settled_change && i + 1 >= min_steps) {
+			break;
+		}
 	}
 }
 
@@ -2042,6 +2089,9 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 					if(state.world.pop_type_get_strata(pop_type) != strata_filter) {
 						return;
 					}
+					if(!pop_type_needs_commodity(state, pop_type, c)) {
+						return;
+					}
 
 					auto life_base = state.world.pop_type_get_life_needs(pop_type, c);
 					auto everyday_base = state.world.pop_type_get_everyday_needs(pop_type, c);
@@ -2120,6 +2170,9 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 					if(state.world.pop_type_get_strata(pop_type) != strata_filter) {
 						return;
 					}
+					if(!pop_type_needs_commodity(state, pop_type, c)) {
+						return;
+					}
 
 					auto life_base = state.world.pop_type_get_life_needs(pop_type, c);
 					auto everyday_base = state.world.pop_type_get_everyday_needs(pop_type, c);
@@ -2197,6 +2250,9 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 					if(state.world.pop_type_get_strata(pop_type) != strata_filter) {
 						return;
 					}
+					if(!pop_type_needs_commodity(state, pop_type, c)) {
+						return;
+					}
 
 					auto life_base = state.world.pop_type_get_life_needs(pop_type, c);
 					auto everyday_base = state.world.pop_type_get_everyday_needs(pop_type, c);
@@ -4289,6 +4345,38 @@ float estimate_daily_income(sys::state& state, dcon::nation_id n) {
 	return tax.mid + tax.poor + tax.rich;
 }
 
+budget_estimates const& cached_budget_estimates(sys::state& state, dcon::nation_id n) {
+	if(state.ui_budget_estimates.size() < state.world.nation_size())
+		state.ui_budget_estimates.resize(state.world.nation_size());
+	auto& r = state.ui_budget_estimates[n.index()];
+	if(r.valid)
+		return r;
+
+	auto tax = explain_tax_income(state, n);
+	r.poor_tax = tax.poor;
+	r.mid_tax = tax.mid;
+	r.rich_tax = tax.rich;
+	r.diplomatic_income = estimate_diplomatic_income(state, n);
+	r.diplomatic_expenses = estimate_diplomatic_expenses(state, n);
+	r.tariff_import_income = estimate_tariff_import_income(state, n);
+	r.tariff_export_income = estimate_tariff_export_income(state, n);
+	r.gold_income = estimate_gold_income(state, n);
+	r.social_spending = estimate_social_spending(state, n);
+	r.education_spending = estimate_education_spending(state, n);
+	r.administration_spending = estimate_spendings_administration(state, n, float(state.world.nation_get_administrative_spending(n)) / 100.f);
+	r.military_payouts = estimate_pop_payouts_by_income_type(state, n, culture::income_type::military);
+	r.max_domestic_investment = estimate_max_domestic_investment(state, n);
+	r.overseas_penalty_spending = estimate_overseas_penalty_spending(state, n);
+	r.subsidy_spending = estimate_subsidy_spending(state, n);
+	r.construction_spending = estimate_construction_spending(state, n);
+	r.land_spending = estimate_land_spending(state, n);
+	r.naval_spending = estimate_naval_spending(state, n);
+	r.interest_payment = interest_payment(state, n);
+	r.stockpile_filling_spending = estimate_stockpile_filling_spending(state, n);
+	r.valid = true;
+	return r;
+}
+
 void try_add_factory_to_state(sys::state& state, dcon::state_instance_id s, dcon::factory_type_id t) {
 	auto province = state.world.state_instance_get_capital(s);
 
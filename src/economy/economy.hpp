@@ -234,6 +234,34 @@ float estimate_subject_payments_received(sys::state& state, dcon::nation_id o);
 
 float estimate_daily_income(sys::state& state, dcon::nation_id n);
 
+// the estimates shown in the budget window; the slider dependent scaling (military, land, naval, overseas, domestic investment)
+// is left to the caller so that the cached values only change when the game state does
+struct budget_estimates {
+	float poor_tax = 0.f;
+	float mid_tax = 0.f;
+	float rich_tax = 0.f;
+	float diplomatic_income = 0.f;
+	float diplomatic_expenses = 0.f;
+	float tariff_import_income = 0.f;
+	float tariff_export_income = 0.f;
+	float gold_income = 0.f;
+	float social_spending = 0.f;
+	float education_spending = 0.f;
+	float administration_spending = 0.f;
+	float military_payouts = 0.f;
+	float max_domestic_investment = 0.f;
+	float overseas_penalty_spending = 0.f;
+	float subsidy_spending = 0.f;
+	float construction_spending = 0.f;
+	float land_spending = 0.f;
+	float naval_spending = 0.f;
+	float interest_payment = 0.f;
+	float stockpile_filling_spending = 0.f;
+	bool valid = false;
+};
+// computed on first request and reused until the next game state update; ui thread only
+budget_estimates const& cached_budget_estimates(sys::state& state, dcon::nation_id n);
+
 struct construction_status {
 	float progress = 0.0f; // in range [0,1)
 	bool is_under_construction = false;
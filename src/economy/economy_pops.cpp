@@ -233,6 +233,14 @@ void update_consumption(
 			for(uint32_t i = 1; i < total_commodities; ++i) {
 				dcon::commodity_id cid{ dcon::commodity_id::value_base_t(i) };
 
+				if(!pop_type_needs_commodity(state, t, cid)) {
+					continue;
+				}
+				auto valid_good_mask = valid_need(state, nations, cid);
+				if(ve::compress_mask(valid_good_mask).v == 0) {
+					continue;
+				}
+
 				auto life_weight =
 					state.world.market_get_life_needs_weights(ids, cid);
 				auto everyday_weight =
@@ -246,8 +254,6 @@ void update_consumption(
 				auto base_luxury =
 					state.world.pop_type_get_luxury_needs(t, cid);
 
-				auto valid_good_mask = valid_need(state, nations, cid);
-
 				auto demand_life =
 					base_life
 					* scale_life
@@ -589,7 +589,122 @@ trade_route_volume_change_reasons predict_trade_route_volume_change(
 	return result;
 }
 
+// compares everything the diplomatic status of trade routes depends on,
+// besides owners and controllers of the connected markets, with the previous day
+bool trade_route_politics_are_current(sys::state& state) {
+	std::vector<uint32_t> snapshot;
+	snapshot.reserve(state.trade_route_politics_snapshot.size());
+
+	state.world.for_each_nation([&](dcon::nation_id n) {
+		snapshot.push_back(uint32_t(state.world.nation_get_in_sphere_of(n).value));
+		snapshot.push_back(uint32_t(state.world.overlord_get_ruler(state.world.nation_get_overlord_as_subject(n)).value));
+		snapshot.push_back(state.world.nation_get_is_at_war(n) ? 1 : 0);
+		for(auto wp : state.world.nation_get_war_participant(n)) {
+			snapshot.push_back(uint32_t(wp.get_war().id.value));
+			snapshot.push_back(wp.get_is_attacker() ? 1 : 0);
+		}
+		snapshot.push_back(0);
+	});
+	state.world.for_each_unilateral_relationship([&](dcon::unilateral_relationship_id r) {
+		auto embargo = state.world.unilateral_relationship_get_embargo(r);
+		auto no_tariffs = bool(state.world.unilateral_relationship_get_no_tariffs_until(r));
+		if(!embargo && !no_tariffs)
+			return;
+		snapshot.push_back(uint32_t(state.world.unilateral_relationship_get_source(r).value));
+		snapshot.push_back(uint32_t(state.world.unilateral_relationship_get_target(r).value));
+		snapshot.push_back((embargo ? 1 : 0) | (no_tariffs ? 2 : 0));
+	});
+
+	if(snapshot == state.trade_route_politics_snapshot)
+		return true;
+	state.trade_route_politics_snapshot = std::move(snapshot);
+	return false;
+}
+
+// wars, embargoes, treaties, spheres and occupied ports between the markets of the route
+void update_trade_route_politics(sys::state& state, dcon::trade_route_id route, dcon::province_id port_A, dcon::province_id port_B) {
+	auto A = state.world.trade_route_get_connected_markets(route, 0);
+	auto B = state.world.trade_route_get_connected_markets(route, 1);
+	auto s_A = state.world.market_get_zone_from_local_market(A);
+	auto s_B = state.world.market_get_zone_from_local_market(B);
+	auto n_A = state.world.state_instance_get_nation_from_state_ownership(s_A);
+	auto n_B = state.world.state_instance_get_nation_from_state_ownership(s_B);
+	auto capital_A = state.world.state_instance_get_capital(s_A);
+	auto capital_B = state.world.state_instance_get_capital(s_B);
+	auto controller_capital_A = state.world.province_get_nation_from_province_control(capital_A);
+	auto controller_capital_B = state.world.province_get_nation_from_province_control(capital_B);
+	auto controller_port_A = state.world.province_get_nation_from_province_control(port_A);
+	auto controller_port_B = state.world.province_get_nation_from_province_control(port_B);
+
+	state.world.trade_route_set_politics_owner_0(route, n_A);
+	state.world.trade_route_set_politics_owner_1(route, n_B);
+	state.world.trade_route_set_politics_capital_controller_0(route, controller_capital_A);
+	state.world.trade_route_set_politics_capital_controller_1(route, controller_capital_B);
+	state.world.trade_route_set_politics_port_controller_0(route, controller_port_A);
+	state.world.trade_route_set_politics_port_controller_1(route, controller_port_B);
+
+	auto sphere_A = state.world.nation_get_in_sphere_of(controller_capital_A);
+	auto sphere_B = state.world.nation_get_in_sphere_of(controller_capital_B);
+	auto overlord_A = state.world.overlord_get_ruler(
+		state.world.nation_get_overlord_as_subject(controller_capital_A)
+	);
+	auto overlord_B = state.world.overlord_get_ruler(
+		state.world.nation_get_overlord_as_subject(controller_capital_B)
+	);
+
+	// US3AC12. Subjects have embargo of overlords propagated onto them
+	auto market_leader_A = overlord_A ? overlord_A : (sphere_A ? sphere_A : n_A);
+	auto market_leader_B = overlord_B ? overlord_B : (sphere_B ? sphere_B : n_B);
+
+	// US3AC15. Equal/unequal trade treaties
+	// Enddt empty signalises revoken agreement
+	// Enddt > cur_date signalises that the agreement can't be broken
+	auto source_tariffs_rel = state.world.get_unilateral_relationship_by_unilateral_pair(controller_capital_B, market_leader_A);
+	auto A_open_to_B = source_tariffs_rel && bool(state.world.unilateral_relationship_get_no_tariffs_until(source_tariffs_rel));
+	auto target_tariffs_rel = state.world.get_unilateral_relationship_by_unilateral_pair(market_leader_B, controller_capital_A);
+	auto B_open_to_A = target_tariffs_rel && bool(state.world.unilateral_relationship_get_no_tariffs_until(target_tariffs_rel));
+
+	state.world.trade_route_set_politics_open_0_to_1(route, sphere_A == controller_capital_B || overlord_A == controller_capital_B || A_open_to_B);
+	state.world.trade_route_set_politics_open_1_to_0(route, sphere_B == controller_capital_A || overlord_B == controller_capital_A || B_open_to_A);
+
+	// US3AC17. if market capital controller is at war with market coastal controller
+	// consider province blockaded
+	state.world.trade_route_set_politics_port_occupied_0(route, military::are_at_war(state, controller_capital_A, controller_port_A));
+	state.world.trade_route_set_politics_port_occupied_1(route, military::are_at_war(state, controller_capital_B, controller_port_B));
+
+	// US3AC9. Wartime embargoes
+	// US3AC10. diplomatic embargos
+	// US3AC11. sphere joins embargo
+	// US3AC12 subject joins embargo
+	// overlord and subject are always in the same war, so overlord wars are not checked separately
+	auto at_war = military::are_at_war(state, controller_capital_A, controller_capital_B);
+
+	auto A_has_embargo =
+		state.world.unilateral_relationship_get_embargo(
+			state.world.get_unilateral_relationship_by_unilateral_pair(controller_capital_B, market_leader_A)
+		)
+		||
+		state.world.unilateral_relationship_get_embargo(
+			state.world.get_unilateral_relationship_by_unilateral_pair(market_leader_A, controller_capital_B)
+		);
+	auto B_has_embargo =
+		state.world.unilateral_relationship_get_embargo(
+			state.world.get_unilateral_relationship_by_unilateral_pair(controller_capital_A, market_leader_B)
+		)
+		||
+		state.world.unilateral_relationship_get_embargo(
+			state.world.get_unilateral_relationship_by_unilateral_pair(market_leader_B, controller_capital_A)
+		);
+
+	auto A_joins_sphere_wide_embargo = A_has_embargo || military::are_at_war(state, sphere_A, controller_capital_B);
+	auto B_joins_sphere_wide_embargo = B_has_embargo || military::are_at_war(state, sphere_B, controller_capital_A);
+
+	state.world.trade_route_set_politics_blocked(route, at_war || A_joins_sphere_wide_embargo || B_joins_sphere_wide_embargo);
+}
+
 void update_trade_routes_volume(sys::state& state) {
+	auto politics_are_current = trade_route_politics_are_current(state);
+
 	auto coastal_capital_buffer = ve::vectorizable_buffer<dcon::province_id, dcon::state_instance_id>(state.world.state_instance_size());
 
 	state.world.execute_parallel_over_state_instance([&](auto ids) {
@@ -637,90 +752,30 @@ void update_trade_routes_volume(sys::state& state) {
 		auto controller_port_A = state.world.province_get_nation_from_province_control(port_A);
 		auto controller_port_B = state.world.province_get_nation_from_province_control(port_B);
 
-		auto sphere_A = state.world.nation_get_in_sphere_of(controller_capital_A);
-		auto sphere_B = state.world.nation_get_in_sphere_of(controller_capital_B);
-
-		auto overlord_A = state.world.overlord_get_ruler(
-			state.world.nation_get_overlord_as_subject(controller_capital_A)
-		);
-		auto overlord_B = state.world.overlord_get_ruler(
-			state.world.nation_get_overlord_as_subject(controller_capital_B)
-		);
-
-		auto has_overlord_mask_A = overlord_A != dcon::nation_id{};
-		auto has_overlord_mask_B = overlord_B != dcon::nation_id{};
-		auto has_sphere_mask_A = sphere_A != dcon::nation_id{};
-		auto has_sphere_mask_B = sphere_B != dcon::nation_id{};
-
-		// US3AC12. Subjects have embargo of overlords propagated onto them
-		auto market_leader_A = ve::select(has_overlord_mask_A, overlord_A, ve::select(has_sphere_mask_A, sphere_A, n_A));
-		auto market_leader_B = ve::select(has_overlord_mask_B, overlord_B, ve::select(has_sphere_mask_B, sphere_B, n_B));
-
-		// US3AC15. Equal/unequal trade treaties
-		auto A_open_to_B = ve::apply([&](auto n_a, auto n_b) {
-			auto source_tariffs_rel = state.world.get_unilateral_relationship_by_unilateral_pair(n_b, n_a);
-			if(source_tariffs_rel) {
-				auto enddt = state.world.unilateral_relationship_get_no_tariffs_until(source_tariffs_rel);
-				// Enddt empty signalises revoken agreement
-				// Enddt > cur_date signalises that the agreement can't be broken
-				if(enddt) {
-					return true;
-				}
-			}
-			return false;
-		}, market_leader_A, controller_capital_B);
-
-		auto B_open_to_A = ve::apply([&](auto n_a, auto n_b) {
-			auto target_tariffs_rel = state.world.get_unilateral_relationship_by_unilateral_pair(n_a, n_b);
-
-			if(target_tariffs_rel) {
-				auto enddt = state.world.unilateral_relationship_get_no_tariffs_until(target_tariffs_rel);
-				if(enddt) {
-					return true;
+		// US3AC9 - US3AC17. diplomatic status of the route depends only on owners and controllers of its markets
+		// and on wars, spheres, subjects and treaties: recompute it only when some of them have changed
+		auto politics_stale = !politics_are_current
+			|| state.world.trade_route_get_politics_owner_0(trade_route) != n_A
+			|| state.world.trade_route_get_politics_owner_1(trade_route) != n_B
+			|| state.world.trade_route_get_politics_capital_controller_0(trade_route) != controller_capital_A
+			|| state.world.trade_route_get_politics_capital_controller_1(trade_route) != controller_capital_B
+			|| state.world.trade_route_get_politics_port_controller_0(trade_route) != controller_port_A
+			|| state.world.trade_route_get_politics_port_controller_1(trade_route) != controller_port_B;
+
+		if(ve::compress_mask(politics_stale).v != 0) {
+			ve::apply([&](dcon::trade_route_id route, dcon::province_id port_a, dcon::province_id port_b, bool stale) {
+				if(stale) {
+					update_trade_route_politics(state, route, port_a, port_b);
 				}
-			}
-
-			return false;
-		}, market_leader_B, controller_capital_A);
-
-		auto A_is_open_to_B = sphere_A == controller_capital_B || overlord_A == controller_capital_B || A_open_to_B;
-		auto B_is_open_to_A = sphere_B == controller_capital_A || overlord_B == controller_capital_A || B_open_to_A;
-
-		// these are not needed at the moment
-		// because overlord and subject are always in the same war
-
-		/*
-		auto A_joins_overlord_embargo = ve::apply([&](auto n_a, auto n_b) {
-			return military::are_at_war(state, n_a, n_b);
-		}, overlord_A, controller_capital_B);
-
-		auto B_joins_overlord_embargo = ve::apply([&](auto n_a, auto n_b) {
-			return military::are_at_war(state, n_a, n_b);
-		}, overlord_B, controller_capital_A);
-		*/
-
-		// US3AC17. if market capital controller is at war with market coastal controller is different
-		// or it's actually blockaded
-		// consider province blockaded
+			}, trade_route, port_A, port_B, politics_stale);
+		}
 
-		ve::mask_vector port_occupied_A = ve::apply([&](auto n_a, auto n_b) {
-			return military::are_at_war(state, n_a, n_b);
-		}, controller_capital_A, controller_port_A);
-		ve::mask_vector port_occupied_B = ve::apply([&](auto n_a, auto n_b) {
-			return military::are_at_war(state, n_a, n_b);
-		}, controller_capital_B, controller_port_B);
+		auto A_is_open_to_B = state.world.trade_route_get_politics_open_0_to_1(trade_route);
+		auto B_is_open_to_A = state.world.trade_route_get_politics_open_1_to_0(trade_route);
 
 		// US3AC16
-		ve::mask_vector is_A_blockaded = state.world.province_get_is_blockaded(port_A) || port_occupied_A;
-		ve::mask_vector is_B_blockaded = state.world.province_get_is_blockaded(port_B) || port_occupied_B;
-
-		// US3AC9. if market capital controllers are at war then we will break the link
-		auto at_war = ve::apply([&](auto n_a, auto n_b) {
-			return military::are_at_war(state, n_a, n_b);
-		}, controller_capital_A, controller_capital_B);
-
-		auto is_A_civ = state.world.nation_get_is_civilized(n_A);
-		auto is_B_civ = state.world.nation_get_is_civilized(n_B);
+		ve::mask_vector is_A_blockaded = state.world.province_get_is_blockaded(port_A) || state.world.trade_route_get_politics_port_occupied_0(trade_route);
+		ve::mask_vector is_B_blockaded = state.world.province_get_is_blockaded(port_B) || state.world.trade_route_get_politics_port_occupied_1(trade_route);
 
 		auto is_sea_route = state.world.trade_route_get_is_sea_route(trade_route);
 		auto is_land_route = state.world.trade_route_get_is_land_route(trade_route);
@@ -737,50 +792,6 @@ void update_trade_routes_volume(sys::state& state) {
 
 		is_sea_route = is_sea_route && !is_A_blockaded && !is_B_blockaded;
 
-		// US3AC9. Wartime embargoes
-		// US3AC10. diplomatic embargos
-		// US3AC11. sphere joins embargo
-		// US3AC12 subject joins embargo
-		auto A_joins_sphere_wide_embargo = ve::apply([&](auto n_a, auto n_b) {
-			return military::are_at_war(state, n_a, n_b);
-		}, sphere_A, controller_capital_B);
-
-		auto B_joins_sphere_wide_embargo = ve::apply([&](auto n_a, auto n_b) {
-			return military::are_at_war(state, n_a, n_b);
-		}, sphere_B, controller_capital_A);
-
-		auto A_has_embargo = ve::apply([&](auto n_a, auto n_b) {
-			auto source_tariffs_rel = state.world.get_unilateral_relationship_by_unilateral_pair(n_b, n_a);
-			auto target_tariffs_rel = state.world.get_unilateral_relationship_by_unilateral_pair(n_a, n_b);
-
-			return state.world.unilateral_relationship_get_embargo(source_tariffs_rel) || state.world.unilateral_relationship_get_embargo(target_tariffs_rel);
-		}, market_leader_A, controller_capital_B);
-
-		A_joins_sphere_wide_embargo = A_has_embargo || A_joins_sphere_wide_embargo;
-
-		auto B_has_embargo = ve::apply([&](auto n_a, auto n_b) {
-			auto source_tariffs_rel = state.world.get_unilateral_relationship_by_unilateral_pair(n_b, n_a);
-			auto target_tariffs_rel = state.world.get_unilateral_relationship_by_unilateral_pair(n_a, n_b);
-
-			return state.world.unilateral_relationship_get_embargo(source_tariffs_rel) || state.world.unilateral_relationship_get_embargo(target_tariffs_rel);
-		}, market_leader_B, controller_capital_A);
-
-		B_joins_sphere_wide_embargo = B_has_embargo || B_joins_sphere_wide_embargo;
-
-		// these are not needed at the moment
-		// because overlord and subject are always in the same war
-
-		/*
-		auto A_joins_overlord_embargo = ve::apply([&](auto n_a, auto n_b) {
-			return military::are_at_war(state, n_a, n_b);
-		}, overlord_A, controller_capital_B);
-
-		auto B_joins_overlord_embargo = ve::apply([&](auto n_a, auto n_b) {
-			return military::are_at_war(state, n_a, n_b);
-		}, overlord_B, controller_capital_A);
-		*/
-
-
 		auto merchant_cut = ve::select(same_nation, ve::fp_vector{ 1.f + economy::merchant_cut_domestic }, ve::fp_vector{ 1.f + economy::merchant_cut_foreign });
 
 		auto import_tariff_A = ve::select(same_nation || A_is_open_to_B, ve::fp_vector{ 0.f }, import_tariff_buffer.get(A));
@@ -816,9 +827,7 @@ void update_trade_routes_volume(sys::state& state) {
 				+ state.world.province_get_labor_price(capital_B, labor::no_education)
 			);
 
-		auto reset_route = at_war
-			|| A_joins_sphere_wide_embargo
-			|| B_joins_sphere_wide_embargo
+		auto reset_route = state.world.trade_route_get_politics_blocked(trade_route)
 			|| trade_banned
 			|| !ve::apply([&](auto r) { return state.world.trade_route_is_valid(r); }, trade_route)
 			|| (!is_sea_route && !is_land_route);
@@ -849,6 +858,11 @@ void update_trade_routes_volume(sys::state& state) {
 			//state.world.execute_serial_over_trade_route([&](auto trade_route) {
 			auto current_volume = state.world.trade_route_get_volume(trade_route, c);
 
+			// closed routes which carry nothing stay empty
+			if(ve::compress_mask(!reset_route_commodity || current_volume != 0.f).v == 0) {
+				continue;
+			}
+
 			auto absolute_volume = ve::abs(current_volume);
 			//auto sat = state.world.market_get_direct_demand_satisfaction(origin, c);
 
@@ -957,6 +971,10 @@ void update_trade_routes_consumption(sys::state& state) {
 
 		state.world.for_each_trade_route([&](auto trade_route) {
 			auto current_volume = state.world.trade_route_get_volume(trade_route, cid);
+			// most routes do not carry most goods: nothing to scale or register
+			if(current_volume == 0.f) {
+				return;
+			}
 			auto origin =
 				current_volume > 0.f
 				? state.world.trade_route_get_connected_markets(trade_route, 0)
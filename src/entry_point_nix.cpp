@@ -98,6 +98,7 @@ void build_scenario_file() {
 		err.accumulated_errors += "File common/bookmarks.txt could not be opened\n";
 	}
 
+	auto content_key = sys::compute_content_checksum(fs_root);
 	sys::checksum_key scenario_key;
 
 	for(uint32_t date_index = 0; date_index < uint32_t(bookmark_context.bookmark_dates.size()); date_index++) {
@@ -119,7 +120,7 @@ void build_scenario_file() {
 			}
 			++max_scenario_count;
 			selected_scenario_file = base_name + NATIVE("-") + std::to_string(append) + NATIVE(".bin");
-			sys::write_scenario_file(*game_state, selected_scenario_file, max_scenario_count);
+			sys::write_scenario_file(*game_state, selected_scenario_file, max_scenario_count, content_key);
 			if(auto of = simple_fs::open_file(sdir, selected_scenario_file); of) {
 				auto content = view_contents(*of);
 				auto desc = sys::extract_mod_information(reinterpret_cast<uint8_t const*>(content.data), content.file_size);
@@ -133,7 +134,7 @@ void build_scenario_file() {
 			scenario_key = game_state->scenario_checksum;
 		} else {
 #ifndef NDEBUG
-			sys::write_scenario_file(*game_state, std::to_string(date_index) + NATIVE(".bin"), 0);
+			sys::write_scenario_file(*game_state, std::to_string(date_index) + NATIVE(".bin"), 0, content_key);
 #endif
 			game_state->scenario_checksum = scenario_key;
 			sys::write_save_file(*game_state, sys::save_type::bookmark, bookmark_context.bookmark_dates[date_index].name_);
@@ -258,12 +259,13 @@ int main (int argc, char *argv[]) {
 				} else {
 					window::emit_error_message("Development test file not found. Proceeding to generate file, this process may take a few minutes to complete.\n", false);
 					parsers::error_handler err{ "" };
+					auto content_key = sys::compute_content_checksum(game_state.common_fs);
 					game_state.load_scenario_data(err, sys::year_month_day{ 1836, 1, 1});
 					if(!err.accumulated_errors.empty() || !err.accumulated_warnings.empty()) {
 						auto assembled_msg = std::string("You can still play the mod, but it might be unstable\r\nThe following problems were encountered while creating the scenario:\r\n\r\nErrors:\r\n") + err.accumulated_errors + "\r\n\r\nWarnings:\r\n" + err.accumulated_warnings;
 						window::emit_error_message(assembled_msg, false);
 					}
-					sys::write_scenario_file(game_state, NATIVE("development_test_file.bin"), 0);
+					sys::write_scenario_file(game_state, NATIVE("development_test_file.bin"), 0, content_key);
 					selected_scenario_file = "development_test_file.bin";
 				}
 				break;
@@ -172,6 +172,7 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/, LPWSTR
 					return ret;
 				};
 
+				auto content_key = sys::compute_content_checksum(fs_root);
 				sys::checksum_key scenario_key;
 				for(uint32_t date_index = 0; date_index < uint32_t(bookmark_context.bookmark_dates.size()); date_index++) {
 					err.accumulated_errors.clear();
@@ -188,7 +189,7 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/, LPWSTR
 						int32_t append = 0;
 						auto time_stamp = uint64_t(std::time(0));
 						auto selected_scenario_file = native_string(NATIVE("development_test_file.bin"));
-						sys::write_scenario_file(*inner_game_state, selected_scenario_file, 0);
+						sys::write_scenario_file(*inner_game_state, selected_scenario_file, 0, content_key);
 						if(auto of = simple_fs::open_file(sdir, selected_scenario_file); of) {
 							auto content = view_contents(*of);
 							auto desc = sys::extract_mod_information(reinterpret_cast<uint8_t const*>(content.data), content.file_size);
@@ -115,12 +115,16 @@ std::optional<file> open_file(unopened_file const& f) {
 }
 
 void reset(file_system& fs) {
+	std::lock_guard lock{ fs.index_lock };
 	fs.ordered_roots.clear();
 	fs.ignored_paths.clear();
+	fs.index.clear();
 }
 
 void add_root(file_system& fs, native_string_view root_path) {
+	std::lock_guard lock{ fs.index_lock };
 	fs.ordered_roots.emplace_back(root_path);
+	fs.index.clear();
 }
 
 void add_relative_root(file_system& fs, native_string_view root_path) {
@@ -145,7 +149,9 @@ void add_relative_root(file_system& fs, native_string_view root_path) {
 		}
 	}
 
+	std::lock_guard lock{ fs.index_lock };
 	fs.ordered_roots.push_back(native_string(module_name) + native_string(root_path));
+	fs.index.clear();
 }
 
 directory get_root(file_system const& fs) {
@@ -166,6 +172,7 @@ native_string extract_state(file_system const& fs) {
 
 void restore_state(file_system& fs, native_string_view data) {
 	simple_fs::reset(fs);
+	std::lock_guard lock{ fs.index_lock };
 	auto break_position = std::find(data.data(), data.data() + data.length(), NATIVE('?'));
 	// Parse ordered roots
 	{
@@ -187,6 +194,7 @@ void restore_state(file_system& fs, native_string_view data) {
 			position = next_semicolon + 1;
 		}
 	}
+	fs.index.clear();
 }
 
 namespace impl {
@@ -197,47 +205,141 @@ bool contains_non_ascii(native_char const* str) {
 	}
 	return false;
 }
+
+bool less_ignoring_case(native_string const& a, native_string const& b) {
+	return std::lexicographical_compare(std::begin(a), std::end(a), std::begin(b), std::end(b),
+			[](native_char const& char1, native_char const& char2) { return tolower(char1) < tolower(char2); });
+}
+
+native_string to_lower(native_string_view str) {
+	native_string result(str);
+	for(auto& c : result)
+		c = native_char(tolower(c));
+	return result;
+}
+
+std::shared_ptr<directory_index const> get_directory_index(file_system const& fs, native_string const& relative_path) {
+	std::lock_guard lock{ fs.index_lock };
+	if(auto it = fs.index.find(relative_path); it != fs.index.end())
+		return it->second;
+
+	auto result = std::make_unique<directory_index>();
+	ankerl::unordered_dense::set<native_string> seen_directories;
+	for(size_t i = fs.ordered_roots.size(); i-- > 0;) {
+		auto const appended_path = fs.ordered_roots[i] + relative_path;
+		if(simple_fs::is_ignored_path(fs, appended_path + NATIVE("/"))) {
+			continue;
+		}
+
+		DIR* d = opendir(appended_path.c_str());
+		if(d) {
+			struct dirent* dir_ent = nullptr;
+			while((dir_ent = readdir(d)) != nullptr) {
+				if(strcmp(dir_ent->d_name, ".") == 0 || strcmp(dir_ent->d_name, "..") == 0)
+					continue;
+
+				native_string const full_path = appended_path + NATIVE("/") + dir_ent->d_name;
+				bool is_file = dir_ent->d_type == DT_REG;
+				bool is_directory = dir_ent->d_type == DT_DIR;
+				// d_type is not filled in by every file system and does not resolve links
+				if(dir_ent->d_type == DT_LNK || dir_ent->d_type == DT_UNKNOWN) {
+					struct stat stat_buf;
+					if(stat(full_path.c_str(), &stat_buf) != -1) {
+						is_file = S_ISREG(stat_buf.st_mode);
+						is_directory = S_ISDIR(stat_buf.st_mode);
+					}
+				}
+
+				if(is_file) {
+					native_string name(dir_ent->d_name);
+					if(result->files_by_name.contains(name))
+						continue; // provided by a root with a higher priority
+					if(simple_fs::is_ignored_path(fs, full_path))
+						continue;
+					result->files_by_name.insert_or_assign(name, uint32_t(0));
+					result->entries.push_back(directory_entry{ std::move(name), full_path, false });
+				} else if(is_directory) {
+					native_string name(dir_ent->d_name);
+					if(seen_directories.contains(name))
+						continue;
+					seen_directories.insert(name);
+					result->entries.push_back(directory_entry{ std::move(name), full_path, true });
+				}
+			}
+			closedir(d);
+		}
+	}
+
+	std::sort(result->entries.begin(), result->entries.end(), [](directory_entry const& a, directory_entry const& b) {
+		if(less_ignoring_case(a.name, b.name))
+			return true;
+		if(less_ignoring_case(b.name, a.name))
+			return false;
+		if(a.name != b.name)
+			return a.name < b.name;
+		return a.is_directory < b.is_directory;
+	});
+	result->files_by_name.clear();
+	for(uint32_t j = 0; j < uint32_t(result->entries.size()); ++j) {
+		auto const& e = result->entries[j];
+		if(e.is_directory)
+			continue;
+		result->files_by_name.insert_or_assign(e.name, j);
+		// the first name in sorted order wins when several differ only by case
+		result->files_by_lowercase_name.try_emplace(to_lower(e.name), j);
+	}
+
+	std::shared_ptr<directory_index const> stored = std::move(result);
+	fs.index.insert_or_assign(relative_path, stored);
+	return stored;
+}
+
+// finds the highest priority copy of a file, falling back to a case insensitive match
+// file_name may contain a relative path
+std::optional<native_string> find_file(directory const& dir, file_system const& fs, native_string_view file_name) {
+	native_string relative_path = get_full_name(dir);
+	if(auto last_sep = file_name.find_last_of(NATIVE('/')); last_sep != native_string_view::npos) {
+		relative_path += NATIVE('/');
+		relative_path += file_name.substr(0, last_sep);
+		file_name = file_name.substr(last_sep + 1);
+	}
+	auto index_ptr = get_directory_index(fs, relative_path);
+	auto const& index = *index_ptr;
+	auto it = index.files_by_name.find(native_string(file_name));
+	if(it == index.files_by_name.end()) {
+		it = index.files_by_lowercase_name.find(to_lower(file_name));
+		if(it == index.files_by_lowercase_name.end())
+			return std::optional<native_string>{};
+	}
+	return std::optional<native_string>(index.entries[it->second].full_path);
+}
 } // namespace impl
 
 std::vector<unopened_file> list_files(directory const& dir, native_char const* extension) {
 	std::vector<unopened_file> accumulated_results;
 	if(dir.parent_system) {
-		for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
-			auto const appended_path = dir.parent_system->ordered_roots[i] + dir.relative_path;
-			if(simple_fs::is_ignored_path(*dir.parent_system, appended_path + NATIVE("/"))) {
+		auto index_ptr = impl::get_directory_index(*dir.parent_system, dir.relative_path);
+		auto const& index = *index_ptr;
+		for(auto const& e : index.entries) {
+			if(e.is_directory)
 				continue;
-			}
-
-			DIR* d = opendir(appended_path.c_str());
-			if(d) {
-				struct dirent* dir_ent = nullptr;
-				while((dir_ent = readdir(d)) != nullptr) {
-					// Check if it's a file. Not POSIX standard but included in Linux
-					if(dir_ent->d_type != DT_REG)
-						continue;
 
-					// Check if the file is of the right extension
-					if(extension && extension[0] != 0) {
-						char* dot = strrchr(dir_ent->d_name, '.');
-						if(!dot || dot == dir_ent->d_name)
-							continue;
-						if(strcmp(dot, extension))
-							continue;
-					}
+			// Check if the file is of the right extension
+			if(extension && extension[0] != 0) {
+				char const* dot = strrchr(e.name.c_str(), '.');
+				if(!dot || dot == e.name.c_str())
+					continue;
+				if(strcmp(dot, extension))
+					continue;
+			}
 
-					if(impl::contains_non_ascii(dir_ent->d_name))
-						continue;
+			if(impl::contains_non_ascii(e.name.c_str()))
+				continue;
 
-					auto search_result = std::find_if(accumulated_results.begin(), accumulated_results.end(),
-							[n = dir_ent->d_name](auto const& f) { return f.file_name.compare(n) == 0; });
-					if(search_result == accumulated_results.end()) {
-						accumulated_results.emplace_back(
-								dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE("/") + dir_ent->d_name, dir_ent->d_name);
-					}
-				}
-				closedir(d);
-			}
+			accumulated_results.emplace_back(e.full_path, e.name);
 		}
+		// the index is already sorted
+		return accumulated_results;
 	} else {
 		auto const appended_path = dir.relative_path;
 		DIR* d = opendir(appended_path.c_str());
@@ -275,34 +377,19 @@ std::vector<unopened_file> list_files(directory const& dir, native_char const* e
 std::vector<directory> list_subdirectories(directory const& dir) {
 	std::vector<directory> accumulated_results;
 	if(dir.parent_system) {
-		for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
-			auto const appended_path = dir.parent_system->ordered_roots[i] + dir.relative_path;
-			if(simple_fs::is_ignored_path(*dir.parent_system, appended_path + NATIVE("/"))) {
+		auto index_ptr = impl::get_directory_index(*dir.parent_system, dir.relative_path);
+		auto const& index = *index_ptr;
+		for(auto const& e : index.entries) {
+			if(!e.is_directory)
 				continue;
-			}
-			DIR* d = opendir(appended_path.c_str());
-			if(d) {
-				struct dirent* dir_ent = nullptr;
-				while((dir_ent = readdir(d)) != nullptr) {
-					// Check if it's a directory. Not POSIX standard but included in Linux
-					if(dir_ent->d_type != DT_DIR)
-						continue;
-
-					if(impl::contains_non_ascii(dir_ent->d_name))
-						continue;
-
-					native_string const rel_name = dir.relative_path + NATIVE("/") + dir_ent->d_name;
-					if(dir_ent->d_name[0] != NATIVE('.')) {
-						auto search_result = std::find_if(accumulated_results.begin(), accumulated_results.end(),
-								[&rel_name](auto const& s) { return s.relative_path.compare(rel_name) == 0; });
-						if(search_result == accumulated_results.end()) {
-							accumulated_results.emplace_back(dir.parent_system, rel_name);
-						}
-					}
-				}
-				closedir(d);
+			if(impl::contains_non_ascii(e.name.c_str()))
+				continue;
+			if(e.name[0] != NATIVE('.')) {
+				accumulated_results.emplace_back(dir.parent_system, dir.relative_path + NATIVE("/") + e.name);
 			}
 		}
+		// the index is already sorted
+		return accumulated_results;
 	} else {
 		auto const appended_path = dir.relative_path;
 		DIR* d = opendir(appended_path.c_str());
@@ -339,15 +426,10 @@ directory open_directory(directory const& dir, native_string_view directory_name
 
 std::optional<file> open_file(directory const& dir, native_string_view file_name) {
 	if(dir.parent_system) {
-		for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
-			native_string dir_path = dir.parent_system->ordered_roots[i] + dir.relative_path;
-			native_string full_path = dir_path + NATIVE('/') + native_string(file_name);
-			if(simple_fs::is_ignored_path(*dir.parent_system, full_path)) {
-				continue;
-			}
-			int file_descriptor = open(full_path.c_str(), O_RDONLY | O_NONBLOCK);
+		if(auto full_path = impl::find_file(dir, *dir.parent_system, file_name); full_path) {
+			int file_descriptor = open(full_path->c_str(), O_RDONLY | O_NONBLOCK);
 			if(file_descriptor != -1) {
-				return std::optional<file>(file(file_descriptor, full_path));
+				return std::optional<file>(file(file_descriptor, *full_path));
 			}
 		}
 	} else {
@@ -362,16 +444,8 @@ std::optional<file> open_file(directory const& dir, native_string_view file_name
 
 std::optional<unopened_file> peek_file(directory const& dir, native_string_view file_name) {
 	if(dir.parent_system) {
-		for(size_t i = dir.parent_system->ordered_roots.size(); i-- > 0;) {
-			native_string full_path = dir.parent_system->ordered_roots[i] + dir.relative_path + NATIVE('/') + native_string(file_name);
-			if(simple_fs::is_ignored_path(*dir.parent_system, full_path)) {
-				continue;
-			}
-			struct stat stat_buf;
-			int result = stat(full_path.c_str(), &stat_buf);
-			if(result != -1 && S_ISREG(stat_buf.st_mode)) {
-				return std::optional<unopened_file>(unopened_file(full_path, file_name));
-			}
+		if(auto full_path = impl::find_file(dir, *dir.parent_system, file_name); full_path) {
+			return std::optional<unopened_file>(unopened_file(*full_path, file_name));
 		}
 	} else {
 		native_string full_path = dir.relative_path + NATIVE('/') + native_string(file_name);
@@ -385,7 +459,9 @@ std::optional<unopened_file> peek_file(directory const& dir, native_string_view
 }
 
 void add_ignore_path(file_system& fs, native_string_view replaced_path) {
+	std::lock_guard lock{ fs.index_lock };
 	fs.ignored_paths.emplace_back(replaced_path);
+	fs.index.clear();
 }
 
 std::vector<native_string> list_roots(file_system const& fs) {
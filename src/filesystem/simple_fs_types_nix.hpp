@@ -1,4 +1,6 @@
 #pragma once
+#include <memory>
+#include <mutex>
 #include "native_types_nix.hpp"
 #include "unordered_dense.h"
 
@@ -7,10 +9,30 @@
 // all in the namespace simple_fs, all classes
 
 namespace simple_fs {
+namespace impl {
+// the merged contents of one directory across all roots
+struct directory_entry {
+	native_string name;
+	native_string full_path; // within the root with the highest priority that contains it
+	bool is_directory = false;
+};
+struct directory_index {
+	std::vector<directory_entry> entries; // sorted by name, ignoring case
+	ankerl::unordered_dense::map<native_string, uint32_t> files_by_name;
+	ankerl::unordered_dense::map<native_string, uint32_t> files_by_lowercase_name;
+};
+// shared so that a listing in use stays valid if the index is dropped meanwhile
+std::shared_ptr<directory_index const> get_directory_index(file_system const& fs, native_string const& relative_path);
+} // namespace impl
+
 class file_system {
 	std::vector<native_string> ordered_roots;
 	std::vector<native_string> ignored_paths;
 
+	// built on first use of a directory and thrown away whenever the roots or ignored paths change
+	mutable ankerl::unordered_dense::map<native_string, std::shared_ptr<impl::directory_index const>> index;
+	mutable std::mutex index_lock;
+
 	void operator=(file_system const& other) = delete;
 	void operator=(file_system&& other) = delete;
 
@@ -29,6 +51,7 @@ public:
 	friend void add_ignore_path(file_system& fs, native_string_view replaced_path);
 	friend std::vector<native_string> list_roots(file_system const& fs);
 	friend bool is_ignored_path(file_system const& fs, native_string_view path);
+	friend std::shared_ptr<impl::directory_index const> impl::get_directory_index(file_system const& fs, native_string const& relative_path);
 };
 
 class directory {
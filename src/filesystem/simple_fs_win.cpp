@@ -149,6 +149,10 @@ bool contains_non_ascii(native_char const* str) {
 	}
 	return false;
 }
+bool less_ignoring_case(native_string const& a, native_string const& b) {
+	return std::lexicographical_compare(std::begin(a), std::end(a), std::begin(b), std::end(b),
+			[](native_char const& char1, native_char const& char2) { return tolower(char1) < tolower(char2); });
+}
 } // namespace impl
 
 std::vector<unopened_file> list_files(directory const& dir, native_char const* extension) {
@@ -193,10 +197,13 @@ std::vector<unopened_file> list_files(directory const& dir, native_char const* e
 			FindClose(find_handle);
 		}
 	}
+	// same order as the linux index: ignoring case, then by exact name
 	std::sort(accumulated_results.begin(), accumulated_results.end(), [](unopened_file const& a, unopened_file const& b) {
-		return std::lexicographical_compare(std::begin(a.file_name), std::end(a.file_name), std::begin(b.file_name),
-				std::end(b.file_name),
-				[](native_char const& char1, native_char const& char2) { return tolower(char1) < tolower(char2); });
+		if(impl::less_ignoring_case(a.file_name, b.file_name))
+			return true;
+		if(impl::less_ignoring_case(b.file_name, a.file_name))
+			return false;
+		return a.file_name < b.file_name;
 	});
 	return accumulated_results;
 }
@@ -242,9 +249,11 @@ std::vector<directory> list_subdirectories(directory const& dir) {
 		}
 	}
 	std::sort(accumulated_results.begin(), accumulated_results.end(), [](directory const& a, directory const& b) {
-		return std::lexicographical_compare(std::begin(a.relative_path), std::end(a.relative_path), std::begin(b.relative_path),
-				std::end(b.relative_path),
-				[](native_char const& char1, native_char const& char2) { return tolower(char1) < tolower(char2); });
+		if(impl::less_ignoring_case(a.relative_path, b.relative_path))
+			return true;
+		if(impl::less_ignoring_case(b.relative_path, a.relative_path))
+			return false;
+		return a.relative_path < b.relative_path;
 	});
 	return accumulated_results;
 }
@@ -64,6 +64,30 @@ void apply_modifier_values_to_province(sys::state& state, dcon::province_id targ
 	}
 }
 
+void apply_scaled_modifier_values_to_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id, float scale) {
+	auto& prov_values = state.world.modifier_get_province_values(mod_id);
+	auto owner = state.world.province_get_nation_from_province_ownership(target_prov);
+	for(uint32_t i = 0; i < sys::provincial_modifier_definition::modifier_definition_size; ++i) {
+		if(!(prov_values.offsets[i]))
+			break; // no more modifier values
+
+		auto fixed_offset = prov_values.offsets[i];
+		auto modifier_amount = prov_values.values[i];
+		auto& current_val = state.world.province_get_modifier_values(target_prov, fixed_offset);
+		state.world.province_set_modifier_values(target_prov, fixed_offset, current_val + modifier_amount * scale);
+	}
+	if(owner) {
+		apply_scaled_modifier_values_to_nation(state, owner, mod_id, scale);
+	}
+}
+
+// the rebuild and the daily expiry only cover land provinces, so sea provinces never have values applied
+static bool has_modifier_values(sys::state& state, dcon::province_id p) {
+	return p.index() < state.province_definitions.first_sea_province.index();
+}
+
+// NOTE: the functions below keep the modifier values in sync with the lists of timed modifiers,
+// so that gaining or losing a modifier takes effect immediately; the monthly rebuild restores exact values
 void add_modifier_to_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id, sys::date expiration) {
 	assert(state.world.nation_is_valid(target_nation) && "Invalid write incoming!");
 	auto lst = state.world.nation_get_current_modifiers(target_nation);
@@ -76,6 +100,7 @@ void add_modifier_to_nation(sys::state& state, dcon::nation_id target_nation, dc
 		}
 	}
 	lst.push_back(sys::dated_modifier{expiration, mod_id});
+	apply_modifier_values_to_nation(state, target_nation, mod_id);
 }
 void add_modifier_to_province(sys::state& state, dcon::province_id target_prov, dcon::modifier_id mod_id, sys::date expiration) {
 	assert(state.world.province_is_valid(target_prov) && "Invalid write incoming!");
@@ -89,6 +114,8 @@ void add_modifier_to_province(sys::state& state, dcon::province_id target_prov,
 		}
 	}
 	lst.push_back(sys::dated_modifier{expiration, mod_id});
+	if(has_modifier_values(state, target_prov))
+		apply_modifier_values_to_province(state, target_prov, mod_id);
 }
 void remove_modifier_from_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id) {
 	auto modifiers_range = state.world.nation_get_current_modifiers(target_nation);
@@ -96,6 +123,7 @@ void remove_modifier_from_nation(sys::state& state, dcon::nation_id target_natio
 	for(uint32_t i = count; i-- > 0;) {
 		if(modifiers_range.at(i).mod_id == mod_id) {
 			modifiers_range.remove_at(i);
+			apply_scaled_modifier_values_to_nation(state, target_nation, mod_id, -1.f);
 			return;
 		}
 	}
@@ -107,6 +135,8 @@ void remove_modifier_from_province(sys::state& state, dcon::province_id target_p
 	for(uint32_t i = count; i-- > 0;) {
 		if(modifiers_range.at(i).mod_id == mod_id) {
 			modifiers_range.remove_at(i);
+			if(has_modifier_values(state, target_prov))
+				apply_scaled_modifier_values_to_province(state, target_prov, mod_id, -1.f);
 			return;
 		}
 	}
@@ -120,10 +150,37 @@ void toggle_modifier_from_province(sys::state& state, dcon::province_id target_p
 	for(uint32_t i = count; i-- > 0;) {
 		if(modifiers_range.at(i).mod_id == mod_id) {
 			modifiers_range.remove_at(i);
+			if(has_modifier_values(state, target_prov))
+				apply_scaled_modifier_values_to_province(state, target_prov, mod_id, -1.f);
 			return;
 		}
 	}
 	lst.push_back(sys::dated_modifier{ expiration, mod_id });
+	if(has_modifier_values(state, target_prov))
+		apply_modifier_values_to_province(state, target_prov, mod_id);
+}
+
+void remove_expired_modifiers_from_nation(sys::state& state, dcon::nation_id target_nation) {
+	auto timed_modifiers = state.world.nation_get_current_modifiers(target_nation);
+	for(uint32_t i = timed_modifiers.size(); i-- > 0;) {
+		if(bool(timed_modifiers[i].expiration) && timed_modifiers[i].expiration < state.current_date) {
+			auto mod_id = timed_modifiers[i].mod_id;
+			timed_modifiers.remove_at(i);
+			apply_scaled_modifier_values_to_nation(state, target_nation, mod_id, -1.f);
+		}
+	}
+}
+
+void remove_expired_modifiers_from_province(sys::state& state, dcon::province_id target_prov) {
+	auto timed_modifiers = state.world.province_get_current_modifiers(target_prov);
+	for(uint32_t i = timed_modifiers.size(); i-- > 0;) {
+		if(bool(timed_modifiers[i].expiration) && timed_modifiers[i].expiration < state.current_date) {
+			auto mod_id = timed_modifiers[i].mod_id;
+			timed_modifiers.remove_at(i);
+			if(has_modifier_values(state, target_prov))
+				apply_scaled_modifier_values_to_province(state, target_prov, mod_id, -1.f);
+		}
+	}
 }
 
 template<typename F>
@@ -522,6 +579,13 @@ void update_single_nation_modifiers(sys::state& state, dcon::nation_id n) {
 				total > 0.0f ? occupied / total : 0.0f);
 	}
 
+	// removing a timed province modifier also subtracts its national part from the owner, so that part must stay counted here
+	for(auto o : state.world.nation_get_province_ownership(n)) {
+		for(auto mpr : state.world.province_get_current_modifiers(o.get_province())) {
+			apply_modifier_values_to_nation(state, n, mpr.mod_id);
+		}
+	}
+
 	if(state.world.nation_get_is_civilized(n) == false) {
 		if(state.national_definitions.unciv_nation)
 			apply_modifier_values_to_nation(state, n, state.national_definitions.unciv_nation);
@@ -670,6 +734,16 @@ void purge_expired_national_province_modifiers(sys::state& state) {
 	}
 }
 
+// expires timed modifiers on the day they run out, should be used on daily update
+void update_timed_modifiers(sys::state& state) {
+	for(auto n : state.world.in_nation) {
+		remove_expired_modifiers_from_nation(state, n);
+	}
+	province::for_each_land_province(state, [&](dcon::province_id p) {
+		remove_expired_modifiers_from_province(state, p);
+	});
+}
+
 // restores values after loading a save
 void repopulate_modifier_effects(sys::state& state) {
 	recreate_national_modifiers(state);
@@ -346,6 +346,7 @@ static_assert(sizeof(dated_modifier) ==
 void repopulate_modifier_effects(sys::state& state);
 
 void update_modifier_effects(sys::state& state);
+void update_timed_modifiers(sys::state& state);
 void update_single_nation_modifiers(sys::state& state, dcon::nation_id n);
 
 void add_modifier_to_nation(sys::state& state, dcon::nation_id target_nation, dcon::modifier_id mod_id,
@@ -100,7 +100,70 @@ mod_identifier extract_mod_information(uint8_t const* ptr_in, uint64_t file_size
 	native_string mod_path;
 	read_mod_path(ptr_in, file_end, mod_path);
 
-	return mod_identifier{ mod_path, h.timestamp, h.count };
+	return mod_identifier{ mod_path, h.timestamp, h.count, h.content_checksum, h.checksum };
+}
+
+// sounds, models and interface textures are only loaded by the running game, so outside of map/ their names and sizes are
+// enough; the map images are read by load_map_data and always have their full contents hashed
+inline bool is_media_file(native_string_view name) {
+	auto const dot = name.find_last_of(NATIVE('.'));
+	if(dot == native_string_view::npos)
+		return false;
+	native_string ext;
+	for(auto c : name.substr(dot))
+		ext.push_back((c >= NATIVE('A') && c <= NATIVE('Z')) ? native_char(c - NATIVE('A') + NATIVE('a')) : c);
+	return ext == NATIVE(".dds") || ext == NATIVE(".tga") || ext == NATIVE(".png") || ext == NATIVE(".ogg")
+		|| ext == NATIVE(".mp3") || ext == NATIVE(".wav") || ext == NATIVE(".xac") || ext == NATIVE(".xsm");
+}
+
+inline void collect_content_files(simple_fs::directory const& dir, native_string const& relative_name, std::vector<std::pair<native_string, simple_fs::unopened_file>>& out) {
+	for(auto& f : simple_fs::list_files(dir, NATIVE(""))) {
+		out.emplace_back(relative_name + simple_fs::get_file_name(f), f);
+	}
+	for(auto& d : simple_fs::list_subdirectories(dir)) {
+		auto full_name = simple_fs::get_full_name(d);
+		auto const sep = full_name.find_last_of(NATIVE("/\\"));
+		auto dir_name = sep == native_string::npos ? full_name : full_name.substr(sep + 1);
+		// the mod folder holds every installed mod, the active one is reached through its own root instead
+		if(relative_name.empty() && dir_name == NATIVE("mod"))
+			continue;
+		collect_content_files(d, relative_name + dir_name + NATIVE("/"), out);
+	}
+}
+
+// the launcher and game builds compile the parsers in the same translation unit as this file, so changing them also changes this
+constexpr inline char engine_build_id[] = __DATE__ " " __TIME__;
+
+checksum_key compute_content_checksum(simple_fs::file_system const& fs) {
+	std::vector<std::pair<native_string, simple_fs::unopened_file>> files;
+	collect_content_files(simple_fs::get_root(fs), native_string{}, files);
+	std::sort(files.begin(), files.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+
+	std::vector<checksum_key> file_keys(files.size());
+	concurrency::parallel_for(size_t(0), files.size(), [&](size_t i) {
+		blake2b_state s;
+		blake2b_init(&s, checksum_key::key_size);
+		blake2b_update(&s, files[i].first.data(), files[i].first.length() * sizeof(native_char));
+		if(auto f = simple_fs::open_file(files[i].second); f) {
+			auto content = simple_fs::view_contents(*f);
+			blake2b_update(&s, &content.file_size, sizeof(content.file_size));
+			if(files[i].first.starts_with(NATIVE("map/")) || !is_media_file(files[i].first))
+				blake2b_update(&s, content.data, content.file_size);
+		}
+		blake2b_final(&s, file_keys[i].key, checksum_key::key_size);
+	});
+
+	// the same files parsed by a different build of the game need not give the same scenario
+	blake2b_state s;
+	blake2b_init(&s, checksum_key::key_size);
+	blake2b_update(&s, file_keys.data(), file_keys.size() * sizeof(checksum_key));
+	uint32_t version = scenario_file_version;
+	blake2b_update(&s, &version, sizeof(version));
+	blake2b_update(&s, engine_build_id, sizeof(engine_build_id));
+
+	checksum_key result;
+	blake2b_final(&s, result.key, checksum_key::key_size);
+	return result;
 }
 
 uint8_t* write_compressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint32_t uncompressed_size) {
@@ -115,6 +178,19 @@ uint8_t* write_compressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint3
 	return ptr_out + sizeof(uint32_t) * 2 + section_length;
 }
 
+// written in place of the decompressed length for sections that are stored without compression
+constexpr inline uint32_t uncompressed_section_marker = 0xFFFFFFFF;
+
+uint8_t* write_uncompressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint32_t uncompressed_size) {
+	uint32_t marker = uncompressed_section_marker;
+
+	memcpy(ptr_out, &uncompressed_size, sizeof(uint32_t));
+	memcpy(ptr_out + sizeof(uint32_t), &marker, sizeof(uint32_t));
+	memcpy(ptr_out + sizeof(uint32_t) * 2, ptr_in, uncompressed_size);
+
+	return ptr_out + sizeof(uint32_t) * 2 + uncompressed_size;
+}
+
 template<typename T>
 uint8_t const* with_decompressed_section(uint8_t const* ptr_in, T const& function) {
 	uint32_t section_length = 0;
@@ -122,6 +198,11 @@ uint8_t const* with_decompressed_section(uint8_t const* ptr_in, T const& functio
 	memcpy(&section_length, ptr_in, sizeof(uint32_t));
 	memcpy(&decompressed_length, ptr_in + sizeof(uint32_t), sizeof(uint32_t));
 
+	if(decompressed_length == uncompressed_section_marker) {
+		function(ptr_in + sizeof(uint32_t) * 2, section_length);
+		return ptr_in + sizeof(uint32_t) * 2 + section_length;
+	}
+
 	uint8_t* temp_buffer = new uint8_t[decompressed_length];
 	// TODO: allocate memory for decompression and decompress into it
 
@@ -827,10 +908,11 @@ size_t sizeof_save_section(sys::state& state) {
 	return sz;
 }
 
-void write_scenario_file(sys::state& state, native_string_view name, uint32_t count) {
+void write_scenario_file(sys::state& state, native_string_view name, uint32_t count, checksum_key const& content_checksum, bool compressed) {
 	scenario_header header;
 	header.count = count;
 	header.timestamp = uint64_t(std::time(nullptr));
+	header.content_checksum = content_checksum;
 
 	auto scenario_space = sizeof_scenario_section(state);
 	size_t save_space = sizeof_save_section(state);
@@ -858,14 +940,20 @@ void write_scenario_file(sys::state& state, native_string_view name, uint32_t co
 	blake2b(checksum, sizeof(*checksum), temp_scenario_buffer + scenario_space.checksum_offset, scenario_space.total_size - scenario_space.checksum_offset, nullptr, 0);
 	state.scenario_checksum = *checksum;
 
-	buffer_position = write_compressed_section(buffer_position, temp_scenario_buffer, uint32_t(scenario_space.total_size));
+	if(compressed)
+		buffer_position = write_compressed_section(buffer_position, temp_scenario_buffer, uint32_t(scenario_space.total_size));
+	else
+		buffer_position = write_uncompressed_section(buffer_position, temp_scenario_buffer, uint32_t(scenario_space.total_size));
 	delete[] temp_scenario_buffer;
 
 	uint8_t* temp_save_buffer = new uint8_t[save_space];
 	auto last_save_written = write_save_section(temp_save_buffer, state);
 	auto last_save_written_count = last_save_written - temp_save_buffer;
 	assert(size_t(last_save_written_count) == save_space);
-	buffer_position = write_compressed_section(buffer_position, temp_save_buffer, uint32_t(save_space));
+	if(compressed)
+		buffer_position = write_compressed_section(buffer_position, temp_save_buffer, uint32_t(save_space));
+	else
+		buffer_position = write_uncompressed_section(buffer_position, temp_save_buffer, uint32_t(save_space));
 	delete[] temp_save_buffer;
 
 	auto total_size_used = buffer_position - temp_buffer;
@@ -153,13 +153,14 @@ inline uint8_t const* deserialize(uint8_t const* ptr_in, ankerl::unordered_dense
 }
 
 constexpr inline uint32_t save_file_version = 44;
-constexpr inline uint32_t scenario_file_version = 139 + save_file_version;
+constexpr inline uint32_t scenario_file_version = 140 + save_file_version;
 
 struct scenario_header {
 	uint32_t version = scenario_file_version;
 	uint32_t count = 0;
 	uint64_t timestamp = 0;
 	checksum_key checksum;
+	checksum_key content_checksum; // of the files the scenario was built from, see compute_content_checksum
 };
 
 struct save_header {
@@ -177,6 +178,8 @@ struct mod_identifier {
 	native_string mod_path;
 	uint64_t timestamp = 0;
 	uint32_t count = 0;
+	checksum_key content_checksum;
+	checksum_key scenario_checksum;
 };
 
 void read_mod_path(uint8_t const* ptr_in, uint8_t const* lim, native_string& path_out);
@@ -193,7 +196,14 @@ size_t sizeof_save_header(save_header const& header_in);
 
 mod_identifier extract_mod_information(uint8_t const* ptr_in, uint64_t file_size);
 
+// hashes the name and contents of every file visible through the file system (only the size of media files outside of map/) together with the scenario
+// version and the time this build of the game was compiled; a scenario whose header carries the same value for the same mod path was built from identical
+// files by the same build and does not need to be rebuilt
+checksum_key compute_content_checksum(simple_fs::file_system const& fs);
+
 uint8_t* write_compressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint32_t uncompressed_size);
+// stores the section as is; reading it back skips decompression and deserializes straight out of the mapped file
+uint8_t* write_uncompressed_section(uint8_t* ptr_out, uint8_t const* ptr_in, uint32_t uncompressed_size);
 
 // Note: these functions are for read / writing the *uncompressed* data
 uint8_t const* read_scenario_section(uint8_t const* ptr_in, uint8_t const* section_end, sys::state& state);
@@ -207,7 +217,8 @@ struct scenario_size {
 scenario_size sizeof_scenario_section(sys::state& state);
 size_t sizeof_save_section(sys::state& state);
 
-void write_scenario_file(sys::state& state, native_string_view name, uint32_t count);
+// content_checksum should be computed before the scenario data is loaded, see compute_content_checksum
+void write_scenario_file(sys::state& state, native_string_view name, uint32_t count, checksum_key const& content_checksum, bool compressed = true);
 bool try_read_scenario_file(sys::state& state, native_string_view name);
 bool try_read_scenario_and_save_file(sys::state& state, native_string_view name);
 bool try_read_scenario_as_save_file(sys::state& state, native_string_view name);
@@ -343,7 +343,14 @@ void state::state_select(dcon::state_definition_id sdef) {
 // window event functions
 //
 
+// input may change what ui elements show, so tooltips built before it can no longer be reused
+static void clear_tooltip_cache(sys::state& state) {
+	if(state.ui_state.tooltip)
+		state.ui_state.tooltip->cache.clear();
+}
+
 void state::on_rbutton_down(int32_t x, int32_t y, key_modifiers mod) {
+	clear_tooltip_cache(*this);
 	game_scene::on_rbutton_down(*this, x, y, mod);
 }
 
@@ -354,6 +361,7 @@ void state::on_mbutton_down(int32_t x, int32_t y, key_modifiers mod) {
 }
 
 void state::on_lbutton_down(int32_t x, int32_t y, key_modifiers mod) {
+	clear_tooltip_cache(*this);
 	if(iui_state.over_ui)
 		iui_state.mouse_pressed = true;
 	else
@@ -365,6 +373,7 @@ void state::on_mbutton_up(int32_t x, int32_t y, key_modifiers mod) {
 	map_state.on_mbuttom_up(x, y, mod);
 }
 void state::on_lbutton_up(int32_t x, int32_t y, key_modifiers mod) {
+	clear_tooltip_cache(*this);
 	game_scene::on_lbutton_up(*this, x, y, mod);
 }
 void state::on_mouse_move(int32_t x, int32_t y, key_modifiers mod) {
@@ -419,6 +428,7 @@ void state::on_resize(int32_t x, int32_t y, window::window_state win_state) {
 }
 
 void state::on_mouse_wheel(int32_t x, int32_t y, key_modifiers mod, float amount) { // an amount of 1.0 is one "click" of the wheel
+	clear_tooltip_cache(*this);
 	//update en demand
 	ui::element_base* root_elm = current_scene.get_root(*this);
 	auto probe_result = root_elm->impl_probe_mouse(*this,
@@ -451,6 +461,7 @@ void state::on_mouse_wheel(int32_t x, int32_t y, key_modifiers mod, float amount
 	}
 }
 void state::on_key_down(virtual_key keycode, key_modifiers mod) {
+	clear_tooltip_cache(*this);
 	if(keycode == virtual_key::CONTROL)
 		ui_state.ctrl_held_down = true;
 	if(keycode == virtual_key::SHIFT || keycode == virtual_key::LSHIFT || keycode == virtual_key::RSHIFT)
@@ -460,6 +471,7 @@ void state::on_key_down(virtual_key keycode, key_modifiers mod) {
 }
 
 void state::on_key_up(virtual_key keycode, key_modifiers mod) {
+	clear_tooltip_cache(*this);
 	if(keycode == virtual_key::CONTROL)
 		ui_state.ctrl_held_down = false;
 	if(keycode == virtual_key::SHIFT || keycode == virtual_key::LSHIFT || keycode == virtual_key::RSHIFT)
@@ -480,11 +492,70 @@ void state::on_key_up(virtual_key keycode, key_modifiers mod) {
 	map_state.on_key_up(keycode, mod);
 }
 void state::on_text(char32_t c) { // c is win1250 codepage value
+	clear_tooltip_cache(*this);
 	if(ui_state.edit_target)
 		ui_state.edit_target->on_text(*this, c);
 }
 
 inline constexpr int32_t tooltip_width = 400;
+inline constexpr size_t tooltip_cache_size = 16;
+inline constexpr auto tooltip_refresh_interval = std::chrono::milliseconds(250);
+
+// builds the tooltip of the hovered element and remembers it for when the element is hovered again
+static void build_tooltip(sys::state& state, ui::element_base* root_elm, ui::xy_pair relative_location, bool cacheable) {
+	auto& tooltip = *state.ui_state.tooltip;
+	auto container = text::create_columnar_layout(state, tooltip.internal_layout,
+		text::layout_parameters{ 0, 0, tooltip_width, int16_t(root_elm->base_data.size.y - 20), state.ui_state.tooltip_font, 0,
+		text::alignment::left, text::text_color::white, true }, 10);
+	state.ui_state.last_tooltip->update_tooltip(state, relative_location.x, relative_location.y, container);
+	ui::populate_shortcut_tooltip(state, *state.ui_state.last_tooltip, container);
+	if(container.native_rtl == text::layout_base::rtl_status::rtl) {
+		container.used_width = -container.used_width;
+		for(auto& t : container.base_layout.contents) {
+			t.x += 16 + container.used_width;
+			t.y += 16;
+		}
+	} else {
+		for(auto& t : container.base_layout.contents) {
+			t.x += 16;
+			t.y += 16;
+		}
+	}
+	tooltip.base_data.size.x = int16_t(container.used_width + 32);
+	tooltip.base_data.size.y = int16_t(container.used_height + 32);
+	if(container.used_width > 0)
+		tooltip.set_visible(state, true);
+	else
+		tooltip.set_visible(state, false);
+
+	tooltip.last_build = std::chrono::steady_clock::now();
+	tooltip.stale = false;
+	if(cacheable) {
+		std::erase_if(tooltip.cache, [&](ui::cached_tooltip const& c) {
+			return c.element_serial == state.ui_state.last_tooltip->serial && c.sub_index == state.ui_state.last_tooltip_sub_index;
+		});
+		if(tooltip.cache.size() >= tooltip_cache_size)
+			tooltip.cache.erase(tooltip.cache.begin());
+		tooltip.cache.push_back(ui::cached_tooltip{ state.ui_state.last_tooltip->serial, state.ui_state.last_tooltip_sub_index, tooltip.internal_layout, tooltip.base_data.size, tooltip.is_visible() });
+	}
+}
+
+static bool restore_cached_tooltip(sys::state& state) {
+	auto& tooltip = *state.ui_state.tooltip;
+	for(auto it = tooltip.cache.begin(); it != tooltip.cache.end(); ++it) {
+		if(it->element_serial == state.ui_state.last_tooltip->serial && it->sub_index == state.ui_state.last_tooltip_sub_index) {
+			// a hit becomes the most recently used entry, so the least recently used one is evicted first
+			std::rotate(it, it + 1, tooltip.cache.end());
+			auto& c = tooltip.cache.back();
+			tooltip.internal_layout = c.contents;
+			tooltip.base_data.size = c.size;
+			tooltip.set_visible(state, c.visible);
+			tooltip.stale = false;
+			return true;
+		}
+	}
+	return false;
+}
 
 void state::render() { // called to render the frame may (and should) delay returning until the frame is rendered, including
 	// waiting for vsync
@@ -494,7 +565,18 @@ void state::render() { // called to render the frame may (and should) delay retu
 	if(!current_scene.get_root)
 		return;
 
+	auto* snapshot = new_ui_snapshots.front();
+	while(snapshot) {
+		current_ui_snapshot = *snapshot;
+		new_ui_snapshots.pop();
+		snapshot = new_ui_snapshots.front();
+	}
 	auto game_state_was_updated = game_state_updated.exchange(false, std::memory_order::acq_rel);
+	if(game_state_was_updated) {
+		for(auto& e : ui_budget_estimates)
+			e.valid = false;
+		++map_state.map_modes.generation;
+	}
 	if(game_state_was_updated && !current_scene.starting_scene && !ui_state.lazy_load_in_game) {
 		window::change_cursor(*this, window::cursor_type::busy);
 		ui::create_in_game_windows(*this);
@@ -507,6 +589,9 @@ void state::render() { // called to render the frame may (and should) delay retu
 			map::update_text_lines(*this, map_state.map_data);
 		}
 	}
+	map::collect_text_lines(*this, map_state.map_data);
+	map_mode::collect_map_mode(*this);
+	ogl::upload_decoded_textures(*this);
 	if(game_state_was_updated) {
 		map_state.map_data.update_fog_of_war(*this);
 	}
@@ -840,37 +925,9 @@ void state::render() { // called to render the frame may (and should) delay retu
 
 		current_scene.on_game_state_update_update_ui(*this);
 
-		if(ui_state.last_tooltip == tooltip_probe.under_mouse && ui_state.last_tooltip_sub_index == tooltip_sub_index && ui_state.last_tooltip && ui_state.tooltip->is_visible()) {
-			auto type = ui_state.last_tooltip->has_tooltip(*this);
-			if(type != ui::tooltip_behavior::position_sensitive_tooltip) {
-				auto container = text::create_columnar_layout(*this, ui_state.tooltip->internal_layout,
-						text::layout_parameters{ 0, 0, tooltip_width, int16_t(root_elm->base_data.size.y - 20), ui_state.tooltip_font, 0,
-								text::alignment::left,
-								text::text_color::white, true },
-							10);
-				ui_state.last_tooltip->update_tooltip(*this, tooltip_probe.relative_location.x, tooltip_probe.relative_location.y,
-						container);
-				populate_shortcut_tooltip(*this, *ui_state.last_tooltip, container);
-				if(container.native_rtl == text::layout_base::rtl_status::rtl) {
-					container.used_width = -container.used_width;
-					for(auto& t : container.base_layout.contents) {
-						t.x += 16 + container.used_width;
-						t.y += 16;
-					}
-				} else {
-					for(auto& t : container.base_layout.contents) {
-						t.x += 16;
-						t.y += 16;
-					}
-				}
-				ui_state.tooltip->base_data.size.x = int16_t(container.used_width + 32);
-				ui_state.tooltip->base_data.size.y = int16_t(container.used_height + 32);
-				if(container.used_width > 0)
-					ui_state.tooltip->set_visible(*this, true);
-				else
-					ui_state.tooltip->set_visible(*this, false);
-			}
-		}
+		// tooltips built before this update are outdated; the hovered one is rebuilt below
+		ui_state.tooltip->cache.clear();
+		ui_state.tooltip->stale = true;
 	} // END game state was updated
 
 	if(ui_state.last_tooltip != tooltip_probe.under_mouse || ui_state.last_tooltip_sub_index != tooltip_sub_index) {
@@ -880,60 +937,23 @@ void state::render() { // called to render the frame may (and should) delay retu
 		if(tooltip_probe.under_mouse) {
 			auto type = ui_state.last_tooltip->has_tooltip(*this);
 			if(type != ui::tooltip_behavior::no_tooltip) {
-				auto container = text::create_columnar_layout(*this, ui_state.tooltip->internal_layout,
-					text::layout_parameters{ 0, 0, tooltip_width,int16_t(root_elm->base_data.size.y - 20), ui_state.tooltip_font, 0,
-					text::alignment::left, text::text_color::white, true }, 10);
-				ui_state.last_tooltip->update_tooltip(*this, tooltip_probe.relative_location.x, tooltip_probe.relative_location.y,
-						container);
-				populate_shortcut_tooltip(*this, *ui_state.last_tooltip, container);
-				if(container.native_rtl == text::layout_base::rtl_status::rtl) {
-					container.used_width = -container.used_width;
-					for(auto& t : container.base_layout.contents) {
-						t.x += 16 + container.used_width;
-						t.y += 16;
-					}
-				} else {
-					for(auto& t : container.base_layout.contents) {
-						t.x += 16;
-						t.y += 16;
-					}
-				}
-				ui_state.tooltip->base_data.size.x = int16_t(container.used_width + 32);
-				ui_state.tooltip->base_data.size.y = int16_t(container.used_height + 32);
-				if(container.used_width > 0)
-					ui_state.tooltip->set_visible(*this, true);
-				else
-					ui_state.tooltip->set_visible(*this, false);
+				if(type == ui::tooltip_behavior::position_sensitive_tooltip || !restore_cached_tooltip(*this))
+					build_tooltip(*this, root_elm, tooltip_probe.relative_location, type != ui::tooltip_behavior::position_sensitive_tooltip);
 			} else {
 				ui_state.tooltip->set_visible(*this, false);
 			}
 		} else {
 			ui_state.tooltip->set_visible(*this, false);
 		}
-	} else if(ui_state.last_tooltip && ui_state.last_tooltip->has_tooltip(*this) == ui::tooltip_behavior::position_sensitive_tooltip) {
-		auto container = text::create_columnar_layout(*this, ui_state.tooltip->internal_layout,
-			text::layout_parameters{ 0, 0, tooltip_width, int16_t(root_elm->base_data.size.y - 20), ui_state.tooltip_font, 0,
-			text::alignment::left, text::text_color::white, true }, 10);
-		ui_state.last_tooltip->update_tooltip(*this, tooltip_probe.relative_location.x, tooltip_probe.relative_location.y, container);
-		populate_shortcut_tooltip(*this, *ui_state.last_tooltip, container);
-		if(container.native_rtl == text::layout_base::rtl_status::rtl) {
-			container.used_width = -container.used_width;
-			for(auto& t : container.base_layout.contents) {
-				t.x += 16 + container.used_width;
-				t.y += 16;
-			}
-		} else {
-			for(auto& t : container.base_layout.contents) {
-				t.x += 16;
-				t.y += 16;
-			}
+	} else if(ui_state.last_tooltip) {
+		auto type = ui_state.last_tooltip->has_tooltip(*this);
+		if(type == ui::tooltip_behavior::position_sensitive_tooltip) {
+			build_tooltip(*this, root_elm, tooltip_probe.relative_location, false);
+		} else if(ui_state.tooltip->stale && ui_state.tooltip->is_visible()) {
+			// at high game speeds an expensive tooltip would otherwise be rebuilt on every tick
+			if(std::chrono::steady_clock::now() - ui_state.tooltip->last_build >= tooltip_refresh_interval)
+				build_tooltip(*this, root_elm, tooltip_probe.relative_location, true);
 		}
-		ui_state.tooltip->base_data.size.x = int16_t(container.used_width + 32);
-		ui_state.tooltip->base_data.size.y = int16_t(container.used_height + 32);
-		if(container.used_width > 0)
-			ui_state.tooltip->set_visible(*this, true);
-		else
-			ui_state.tooltip->set_visible(*this, false);
 	}
 
 	if(ui_state.last_tooltip && ui_state.tooltip->is_visible()) {
@@ -1118,6 +1138,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 
 	current_scene.render_ui(*this);
 
+	ogl::begin_ui_batch(*this);
 	root_elm->impl_render(*this, 0, 0);
 	ui_animation.render(*this);
 
@@ -1140,6 +1161,7 @@ void state::render() { // called to render the frame may (and should) delay retu
 			ui_state.tooltip->impl_render(*this, ui_state.tooltip->base_data.position.x, ui_state.tooltip->base_data.position.y);
 		}
 	}
+	ogl::end_ui_batch(*this);
 	/*render_semaphore.release();*/
 }
 
@@ -1809,6 +1831,41 @@ void state::open_diplomacy(dcon::nation_id target) {
 	}
 }
 
+// how many files parse_files_prefaulted keeps open at a time, well below the usual descriptor limits
+constexpr inline size_t prefault_window = 64;
+
+// the parsers write directly into the scenario as they go, so they have to run one file at a time and in order
+// what can be done ahead of them is opening the files and faulting their contents into memory, which happens on the
+// thread pool one window at a time; fn(i, file) is then called in list order and the window is closed before the next
+// one is opened, so fn must move the file out if it has to outlive the call
+template<typename F>
+static void parse_files_prefaulted(std::vector<simple_fs::unopened_file> const& files, parsers::error_handler& err, F&& fn) {
+	std::vector<std::optional<simple_fs::file>> window(std::min(files.size(), prefault_window));
+	for(size_t start = 0; start < files.size(); start += prefault_window) {
+		auto const count = std::min(files.size() - start, prefault_window);
+		concurrency::parallel_for(size_t(0), count, [&](size_t i) {
+			window[i] = simple_fs::open_file(files[start + i]);
+			if(window[i]) {
+				auto content = simple_fs::view_contents(*window[i]);
+				uint8_t touched = 0;
+				for(uint32_t j = 0; j < content.file_size; j += 4096) {
+					touched ^= uint8_t(content.data[j]);
+				}
+				volatile uint8_t sink = touched;
+				(void)sink;
+			}
+		});
+		for(size_t i = 0; i < count; ++i) {
+			if(window[i]) {
+				fn(start + i, *window[i]);
+			} else {
+				err.accumulated_errors += "File " + simple_fs::native_to_utf8(simple_fs::get_full_name(files[start + i])) + " could not be opened\n";
+			}
+			window[i].reset();
+		}
+	}
+}
+
 void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day bookmark_date) {
 	auto root = get_root(common_fs);
 	auto common = open_directory(root, NATIVE("common"));
@@ -2398,13 +2455,17 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 					parsers::parse_csv_province_history_file(*this, content.data, content.data + content.file_size, err, context);
 				}
 			}
-			for(auto prov_file : list_files(subdir, NATIVE(".txt"))) {
+			auto prov_files = list_files(subdir, NATIVE(".txt"));
+			// exclude files starting with "~" for example, before they are opened
+			std::erase_if(prov_files, [](simple_fs::unopened_file const& f) {
+				auto file_name = get_file_name(f);
+				return !file_name.empty() && !(file_name[0] >= NATIVE('0') && file_name[0] <= NATIVE('9'));
+			});
+			parse_files_prefaulted(prov_files, err, [&](size_t i, simple_fs::file& opened_file) {
+				auto const& prov_file = prov_files[i];
 				auto file_name = simple_fs::native_to_utf8(get_file_name(prov_file));
 				auto name_start = file_name.c_str();
 				auto name_end = name_start + file_name.length();
-				// exclude files starting with "~" for example
-				if(name_start < name_end && !isdigit(*name_start))
-					continue;
 
 				auto value_start = name_start;
 				for(; value_start < name_end; ++value_start) {
@@ -2420,18 +2481,14 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 				err.file_name = simple_fs::native_to_utf8(get_full_name(prov_file));
 				auto province_id = parsers::parse_uint(std::string_view(value_start, value_end), 0, err);
 				if(province_id > 0 && uint32_t(province_id) < context.original_id_to_prov_id_map.size()) {
-					auto opened_file = open_file(prov_file);
-					if(opened_file) {
-						auto pid = context.original_id_to_prov_id_map[province_id];
-						parsers::province_file_context pf_context{ context, pid };
-						auto content = view_contents(*opened_file);
-						parsers::token_generator gen(content.data, content.data + content.file_size);
-						parsers::parse_province_history_file(gen, err, pf_context);
-						context.state.world.province_set_provid(pid, province_id);
-
-					}
+					auto pid = context.original_id_to_prov_id_map[province_id];
+					parsers::province_file_context pf_context{ context, pid };
+					auto content = view_contents(opened_file);
+					parsers::token_generator gen(content.data, content.data + content.file_size);
+					parsers::parse_province_history_file(gen, err, pf_context);
+					context.state.world.province_set_provid(pid, province_id);
 				}
-			}
+			});
 			};
 		load_from_dir(prov_history);
 		for(auto const& subdir : list_subdirectories(prov_history)) {
@@ -2454,15 +2511,12 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 		// assert(directory_file_count > 0); // Since we expect to test on vanilla and proper mods - this is a useful test.
 		if(directory_file_count == 0)
 			date_directory = open_directory(pop_history, simple_fs::utf8_to_native("1836.1.1"));
-		for(auto pop_file : list_files(date_directory, NATIVE(".txt"))) {
-			auto opened_file = open_file(pop_file);
-			if(opened_file) {
-				err.file_name = simple_fs::native_to_utf8(get_full_name(*opened_file));
-				auto content = view_contents(*opened_file);
-				parsers::token_generator gen(content.data, content.data + content.file_size);
-				parsers::parse_pop_history_file(gen, err, context);
-			}
-		}
+		parse_files_prefaulted(list_files(date_directory, NATIVE(".txt")), err, [&](size_t, simple_fs::file& opened_file) {
+			err.file_name = simple_fs::native_to_utf8(get_full_name(opened_file));
+			auto content = view_contents(opened_file);
+			parsers::token_generator gen(content.data, content.data + content.file_size);
+			parsers::parse_pop_history_file(gen, err, context);
+		});
 		// Modding extension:
 		// Support loading pops from a CSV file, this to condense them better and allow
 		// for them to load faster and better ordered, editable with a spreadsheet program
@@ -2655,30 +2709,24 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 	// load decisions
 	{
 		auto decisions = open_directory(root, NATIVE("decisions"));
-		for(auto decision_file : list_files(decisions, NATIVE(".txt"))) {
-			auto opened_file = open_file(decision_file);
-			if(opened_file) {
-				err.file_name = simple_fs::native_to_utf8(get_full_name(*opened_file));
-				auto content = view_contents(*opened_file);
-				parsers::token_generator gen(content.data, content.data + content.file_size);
-				parsers::parse_decision_file(gen, err, context);
-			}
-		}
+		parse_files_prefaulted(list_files(decisions, NATIVE(".txt")), err, [&](size_t, simple_fs::file& opened_file) {
+			err.file_name = simple_fs::native_to_utf8(get_full_name(opened_file));
+			auto content = view_contents(opened_file);
+			parsers::token_generator gen(content.data, content.data + content.file_size);
+			parsers::parse_decision_file(gen, err, context);
+		});
 	}
 	// load events
 	{
 		auto events = open_directory(root, NATIVE("events"));
 		std::vector<simple_fs::file> held_open_files;
-		for(auto event_file : list_files(events, NATIVE(".txt"))) {
-			auto opened_file = open_file(event_file);
-			if(opened_file) {
-				err.file_name = simple_fs::native_to_utf8(get_full_name(*opened_file));
-				auto content = view_contents(*opened_file);
-				parsers::token_generator gen(content.data, content.data + content.file_size);
-				parsers::parse_event_file(gen, err, context);
-				held_open_files.emplace_back(std::move(*opened_file));
-			}
-		}
+		parse_files_prefaulted(list_files(events, NATIVE(".txt")), err, [&](size_t, simple_fs::file& opened_file) {
+			err.file_name = simple_fs::native_to_utf8(get_full_name(opened_file));
+			auto content = view_contents(opened_file);
+			parsers::token_generator gen(content.data, content.data + content.file_size);
+			parsers::parse_event_file(gen, err, context);
+			held_open_files.emplace_back(std::move(opened_file));
+		});
 		err.file_name = "pending events";
 		parsers::commit_pending_events(err, context);
 	}
@@ -3379,6 +3427,8 @@ void state::load_scenario_data(parsers::error_handler& err, sys::year_month_day
 }
 
 void state::reset_state() {
+	// a map mode build still running on its worker would read the world while it is replaced
+	map_mode::discard_map_mode_colors(*this);
 
 	/*unit_names.clear();
 	unit_names_indices.clear();
@@ -3408,6 +3458,8 @@ void state::reset_state() {
 	future_p_event*/
 
 	adjacency_data_out_of_date = true;
+	pending_ownership_changes.clear();
+	trade_route_politics_snapshot.clear();
 
 	dcon::load_record loaded;
 	scenario_size scenario_sz = sizeof_scenario_section(*this);
@@ -3439,6 +3491,8 @@ void state::reset_state() {
 void state::preload() {
 
 	adjacency_data_out_of_date = true;
+	pending_ownership_changes.clear();
+	trade_route_politics_snapshot.clear();
 	for(auto si : world.in_state_instance) {
 		si.set_naval_base_is_taken(false);
 		//si.set_capital(dcon::province_id{});
@@ -3826,6 +3880,30 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 	nations_by_prestige_score.resize(2000);
 	crisis_participants.resize(2000);
 
+	free_national_event_prefilters.resize(world.free_national_event_size());
+	for(auto e : world.in_free_national_event) {
+		free_national_event_prefilters[e] = trigger_prefilter{ };
+		trigger::add_to_prefilter(*this, free_national_event_prefilters[e], e.get_trigger());
+	}
+	free_provincial_event_prefilters.resize(world.free_provincial_event_size());
+	for(auto e : world.in_free_provincial_event) {
+		free_provincial_event_prefilters[e] = trigger_prefilter{ };
+		trigger::add_to_prefilter(*this, free_provincial_event_prefilters[e], e.get_trigger());
+	}
+	decision_prefilters.resize(world.decision_size());
+	for(auto d : world.in_decision) {
+		decision_prefilters[d] = trigger_prefilter{ };
+		trigger::add_to_prefilter(*this, decision_prefilters[d], d.get_potential());
+		trigger::add_to_prefilter(*this, decision_prefilters[d], d.get_allow());
+	}
+	decision_potential_inputs.resize(world.decision_size());
+	for(auto d : world.in_decision) {
+		decision_potential_inputs[d] = trigger::read_inputs(*this, d.get_potential());
+	}
+	decision_potential_cache_stride = (world.nation_size() + 63) / 64;
+	decision_potential_cache.assign(size_t(world.decision_size()) * decision_potential_cache_stride, 0);
+	decision_potential_cache_valid.assign(world.decision_size(), 0);
+
 	selected_regiments.resize(const_max_selected_units);
 	selected_ships.resize(const_max_selected_units);
 
@@ -4294,6 +4372,7 @@ void state::single_game_tick() {
 
 		province::update_colonization(*this);
 		military::update_cbs(*this); // may add/remove cbs to a nation
+		sys::update_timed_modifiers(*this); // removes the effects of expired timed modifiers
 
 		event::update_events(*this);
 
@@ -4578,6 +4657,7 @@ void state::single_game_tick() {
 	}
 
 	ui_date = current_date;
+	publish_ui_snapshot();
 
 	game_state_updated.store(true, std::memory_order::release);
 
@@ -4729,6 +4809,40 @@ void state::debug_scenario_oos_dump() {
 	}
 }
 
+void state::publish_ui_snapshot() {
+	ui_snapshot snapshot;
+	snapshot.date = current_date;
+	snapshot.nation = local_player_nation;
+	if(auto* cache = find_player_data_cache(local_player_nation)) {
+		snapshot.records = *cache;
+		snapshot.has_records = true;
+	}
+	if(local_player_nation) {
+		auto total_pop = world.nation_get_demographics(local_player_nation, demographics::total);
+		snapshot.treasury = nations::get_treasury(*this, local_player_nation);
+		snapshot.population = total_pop;
+		snapshot.prestige = nations::prestige_score(*this, local_player_nation);
+		snapshot.infamy = world.nation_get_infamy(local_player_nation);
+		snapshot.literacy = nations::get_avg_non_colonial_literacy(*this, local_player_nation);
+		snapshot.militancy = total_pop == 0.f ? 0.f : world.nation_get_demographics(local_player_nation, demographics::militancy) / total_pop;
+		snapshot.consciousness = total_pop == 0.f ? 0.f : world.nation_get_demographics(local_player_nation, demographics::consciousness) / total_pop;
+		snapshot.diplomatic_points = nations::diplomatic_points(*this, local_player_nation);
+		snapshot.status = nations::get_status(*this, local_player_nation);
+		snapshot.private_investment = world.nation_get_private_investment(local_player_nation);
+		snapshot.literacy_change = demographics::get_estimated_literacy_change(*this, local_player_nation);
+		snapshot.total_literacy = nations::get_avg_total_literacy(*this, local_player_nation);
+		snapshot.militancy_change = demographics::get_estimated_mil_change(*this, local_player_nation);
+		snapshot.consciousness_change = demographics::get_estimated_con_change(*this, local_player_nation);
+		snapshot.monthly_diplomatic_points = nations::monthly_diplomatic_points(*this, local_player_nation);
+		snapshot.monthly_pop_increase = nations::get_monthly_pop_increase_of_nation(*this, local_player_nation);
+	}
+	// if the render thread has fallen behind the queue is full, it will pick up the next snapshot instead
+	if(new_ui_snapshots.try_push(snapshot)) {
+		published_ui_date = current_date;
+		published_ui_nation = local_player_nation;
+	}
+}
+
 void state::game_loop() {
 	static int32_t game_speed[] = {
 		0,		// speed 0
@@ -4746,7 +4860,11 @@ void state::game_loop() {
 		network::send_and_receive_commands(*this);	
 		{
 			std::lock_guard l{ ugly_ui_game_interaction_hack };
+			bool had_commands = incoming_commands.front() != nullptr;
 			command::execute_pending_commands(*this);
+			// loading a save or picking a nation changes the date or the player without a tick
+			if(had_commands || published_ui_date != current_date || published_ui_nation != local_player_nation)
+				publish_ui_snapshot();
 		}
 		if(network_mode == sys::network_mode_type::client) {
 			std::this_thread::sleep_for(std::chrono::milliseconds(15));
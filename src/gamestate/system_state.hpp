@@ -476,6 +476,33 @@ struct player_data { // currently this data is serialized via memcpy, to make su
 	std::array<float, 32> population_record = { 0.0f }; // current day's value = date.value & 31
 };
 
+// the values shown by the top bar and its tooltips, copied by the game thread between updates and handed to the render
+// thread through new_ui_snapshots, so that the ui never reads them while a tick or a command is changing them; the lists
+// of active modifiers in those tooltips and the rest of the ui still read the world directly
+struct ui_snapshot {
+	sys::date date = sys::date{0};
+	dcon::nation_id nation;
+	player_data records;
+	bool has_records = false;
+	float treasury = 0.f;
+	float population = 0.f;
+	float prestige = 0.f;
+	float infamy = 0.f;
+	float literacy = 0.f;
+	float militancy = 0.f;
+	float consciousness = 0.f;
+	float diplomatic_points = 0.f;
+	// only shown in tooltips
+	nations::status status = nations::status::primitive;
+	float private_investment = 0.f;
+	float literacy_change = 0.f;
+	float total_literacy = 0.f;
+	float militancy_change = 0.f;
+	float consciousness_change = 0.f;
+	float monthly_diplomatic_points = 0.f;
+	int64_t monthly_pop_increase = 0;
+};
+
 // the state struct will eventually include (at least pointers to)
 // the state of the sound system, the state of the windowing system,
 // and the game data / state itself
@@ -516,13 +543,24 @@ struct alignas(64) state {
 	ankerl::unordered_dense::map<dcon::text_key, uint32_t, text::vector_backed_ci_hash, text::vector_backed_ci_eq> locale_key_to_text_sequence;
 
 	bool adjacency_data_out_of_date = true;
+	std::vector<province::ownership_change> pending_ownership_changes; // applied incrementally by province::update_connected_regions
 	bool national_cached_values_out_of_date = false;
 	bool diplomatic_cached_values_out_of_date = false;
+	std::vector<uint32_t> trade_route_politics_snapshot; // diplomatic inputs of the cached trade route status
 	std::vector<dcon::nation_id> nations_by_rank;
 	std::vector<dcon::nation_id> nations_by_industrial_score;
 	std::vector<dcon::nation_id> nations_by_military_score;
 	std::vector<dcon::nation_id> nations_by_prestige_score;
 	std::vector<great_nation> great_nations;
+	// necessary conditions lifted from the triggers of free events and decisions, rebuilt in fill_unsaved_data
+	tagged_vector<trigger_prefilter, dcon::free_national_event_id> free_national_event_prefilters;
+	tagged_vector<trigger_prefilter, dcon::free_provincial_event_id> free_provincial_event_prefilters;
+	tagged_vector<trigger_prefilter, dcon::decision_id> decision_prefilters;
+	// inputs read by each decision's potential trigger and the last result per nation, one row of nation bits per decision
+	tagged_vector<uint32_t, dcon::decision_id> decision_potential_inputs;
+	std::vector<uint64_t> decision_potential_cache;
+	std::vector<uint8_t> decision_potential_cache_valid; // per decision, cleared when a pass skips the decision
+	uint32_t decision_potential_cache_stride = 0; // words per row
 
 	uint64_t scenario_time_stamp = 0;	// for identifying the scenario file
 	uint32_t scenario_counter = 0;		// for identifying the scenario file
@@ -611,6 +649,10 @@ struct alignas(64) state {
 
 		return nullptr;
 	}
+	std::vector<economy::budget_estimates> ui_budget_estimates; // see economy::cached_budget_estimates
+	ui_snapshot current_ui_snapshot; // the latest snapshot received by the render thread
+	sys::date published_ui_date = sys::date{0}; // game thread only
+	dcon::nation_id published_ui_nation; // game thread only
 	std::vector<dcon::army_id> selected_armies;
 	std::vector<dcon::regiment_id> selected_regiments; // selected regiments inside the army
 
@@ -668,6 +710,7 @@ struct alignas(64) state {
 	rigtorp::SPSCQueue<notification::message> new_messages;
 	rigtorp::SPSCQueue<military::naval_battle_report> naval_battle_reports;
 	rigtorp::SPSCQueue<military::land_battle_report> land_battle_reports;
+	rigtorp::SPSCQueue<ui_snapshot> new_ui_snapshots;
 
 	// internal game timer / update logic
 	std::chrono::time_point<std::chrono::steady_clock> last_update = std::chrono::steady_clock::now();
@@ -733,6 +776,8 @@ struct alignas(64) state {
 	               // for vsync
 
 	void single_game_tick();
+	// copies the values read by the top bar and hands them to the render thread, called by the game thread only
+	void publish_ui_snapshot();
 	// this function runs the internal logic of the game. It will return *only* after a quit notification is sent to it
 	void game_loop();
 	sys::checksum_key get_save_checksum();
@@ -770,7 +815,7 @@ struct alignas(64) state {
 	dcon::trigger_key commit_trigger_data(std::vector<uint16_t> data);
 	dcon::effect_key commit_effect_data(std::vector<uint16_t> data);
 
-	state() : untrans_key_to_text_sequence(0, text::vector_backed_ci_hash(key_data), text::vector_backed_ci_eq(key_data)), locale_key_to_text_sequence(0, text::vector_backed_ci_hash(key_data), text::vector_backed_ci_eq(key_data)), current_scene(game_scene::nation_picker()), incoming_commands(1024), new_n_event(1024), new_f_n_event(1024), new_p_event(1024), new_f_p_event(1024), new_requests(256), new_messages(2048), naval_battle_reports(256), land_battle_reports(256) {
+	state() : untrans_key_to_text_sequence(0, text::vector_backed_ci_hash(key_data), text::vector_backed_ci_eq(key_data)), locale_key_to_text_sequence(0, text::vector_backed_ci_hash(key_data), text::vector_backed_ci_eq(key_data)), current_scene(game_scene::nation_picker()), incoming_commands(1024), new_n_event(1024), new_f_n_event(1024), new_p_event(1024), new_f_p_event(1024), new_requests(256), new_messages(2048), naval_battle_reports(256), land_battle_reports(256), new_ui_snapshots(16) {
 
 		key_data.push_back(0);
 	}
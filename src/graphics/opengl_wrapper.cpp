@@ -454,6 +454,16 @@ void load_shaders(sys::state& state) {
 	}
 }
 
+// one of the 8x8 glyph cells of a font texture
+static void fill_sub_square(uint32_t i, GLfloat* out) {
+	float const cell_x = static_cast<float>(i & 7) / 8.0f;
+	float const cell_y = static_cast<float>((i >> 3) & 7) / 8.0f;
+
+	GLfloat const data[] = {0.0f, 0.0f, cell_x, cell_y, 0.0f, 1.0f, cell_x, cell_y + 1.0f / 8.0f, 1.0f, 1.0f,
+			cell_x + 1.0f / 8.0f, cell_y + 1.0f / 8.0f, 1.0f, 0.0f, cell_x + 1.0f / 8.0f, cell_y};
+	std::copy_n(data, 16, out);
+}
+
 void load_global_squares(sys::state& state) {
 	// Populate the position buffer
 	glGenBuffers(1, &state.open_gl.global_square_buffer);
@@ -521,14 +531,13 @@ void load_global_squares(sys::state& state) {
 	for(uint32_t i = 0; i < 64; ++i) {
 		glBindBuffer(GL_ARRAY_BUFFER, state.open_gl.sub_square_buffers[i]);
 
-		float const cell_x = static_cast<float>(i & 7) / 8.0f;
-		float const cell_y = static_cast<float>((i >> 3) & 7) / 8.0f;
-
-		GLfloat global_sub_square_data[] = {0.0f, 0.0f, cell_x, cell_y, 0.0f, 1.0f, cell_x, cell_y + 1.0f / 8.0f, 1.0f, 1.0f,
-				cell_x + 1.0f / 8.0f, cell_y + 1.0f / 8.0f, 1.0f, 0.0f, cell_x + 1.0f / 8.0f, cell_y};
+		GLfloat global_sub_square_data[16];
+		fill_sub_square(i, global_sub_square_data);
 
 		glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 16, global_sub_square_data, GL_STATIC_DRAW);
 	}
+
+	glGenBuffers(1, &state.open_gl.ui_batch_buffer);
 }
 
 inline auto map_color_modification_to_index(color_modification e) {
@@ -568,12 +577,72 @@ void bind_vertices_by_rotation(sys::state const& state, ui::rotation r, bool fli
 	}
 }
 
+static GLfloat const* square_by_rotation(ui::rotation r, bool flipped, bool rtl) {
+	switch(r) {
+	case ui::rotation::upright:
+	default:
+		if(!flipped)
+			return rtl ? global_rtl_square_data : global_square_data;
+		else
+			return rtl ? global_rtl_square_flipped_data : global_square_flipped_data;
+	case ui::rotation::r90_left:
+		if(!flipped)
+			return rtl ? global_rtl_square_left_data : global_square_left_data;
+		else
+			return rtl ? global_rtl_square_left_flipped_data : global_square_left_flipped_data;
+	case ui::rotation::r90_right:
+		if(!flipped)
+			return rtl ? global_rtl_square_right_data : global_square_right_data;
+		else
+			return rtl ? global_rtl_square_right_flipped_data : global_square_right_flipped_data;
+	}
+}
+
+void begin_ui_batch(sys::state const& state) {
+	state.open_gl.ui_sprites.clear();
+	state.open_gl.ui_sprites.active = true;
+}
+
+void flush_ui_batch(sys::state const& state) {
+	auto& batch = state.open_gl.ui_sprites;
+	if(batch.empty())
+		return;
+
+	batch.build();
+
+	glBindVertexArray(state.open_gl.global_square_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, state.open_gl.ui_batch_buffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(ui_batch_vertex) * batch.vertices.size(), batch.vertices.data(), GL_STREAM_DRAW);
+	glBindVertexBuffer(0, state.open_gl.ui_batch_buffer, 0, sizeof(GLfloat) * 4);
+
+	// the vertices are already in screen coordinates
+	glUniform4f(state.open_gl.ui_shader_d_rect_uniform, 0.0f, 0.0f, 1.0f, 1.0f);
+	glActiveTexture(GL_TEXTURE0);
+	for(auto& run : batch.runs) {
+		glBindTexture(GL_TEXTURE_2D, run.key.texture);
+		glUniform2ui(state.open_gl.ui_shader_subroutines_index_uniform, run.key.coloring, run.key.filter);
+		if(run.key.filter != parameters::no_filter) {
+			glUniform3f(state.open_gl.ui_shader_inner_color_uniform, run.key.r, run.key.g, run.key.b);
+			glUniform1f(state.open_gl.ui_shader_border_size_uniform, run.key.border_size);
+		}
+		glDrawArrays(GL_TRIANGLES, GLint(run.first), GLsizei(run.count));
+	}
+
+	batch.clear();
+}
+
+void end_ui_batch(sys::state const& state) {
+	flush_ui_batch(state);
+	state.open_gl.ui_sprites.active = false;
+}
+
 void render_colored_rect(
 	sys::state const& state,
 	float x, float y, float width, float height,
 	float red, float green, float blue,
 	ui::rotation r, bool flipped, bool rtl
 ) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 	bind_vertices_by_rotation(state, r, flipped, rtl);
 	glUniform4f(state.open_gl.ui_shader_d_rect_uniform, x, y, width, height);
@@ -590,6 +659,7 @@ void render_alpha_colored_rect(
 	float x, float y, float width, float height,
 	float red, float green, float blue, float alpha
 ) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
 	glUniform4f(state.open_gl.ui_shader_d_rect_uniform, x, y, width, height);
@@ -610,6 +680,15 @@ void render_simple_rect(sys::state const& state, float x, float y, float width,
 
 void render_textured_rect(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
 		GLuint texture_handle, ui::rotation r, bool flipped, bool rtl) {
+	if(state.open_gl.ui_sprites.active) {
+		ui_batch_key key;
+		key.texture = texture_handle;
+		key.coloring = map_color_modification_to_index(enabled);
+		key.filter = parameters::no_filter;
+		state.open_gl.ui_sprites.record(key, x, y, width, height, square_by_rotation(r, flipped, rtl));
+		return;
+	}
+
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped, rtl);
@@ -628,6 +707,7 @@ void render_textured_rect(sys::state const& state, color_modification enabled, f
 }
 
 void render_textured_rect_direct(sys::state const& state, float x, float y, float width, float height, uint32_t handle) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
@@ -646,6 +726,7 @@ void render_textured_rect_direct(sys::state const& state, float x, float y, floa
 
 void render_linegraph(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
 		lines& l) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	l.bind_buffer();
@@ -676,6 +757,7 @@ void render_linegraph(sys::state const& state, color_modification enabled, float
 
 void render_linegraph(sys::state const& state, color_modification enabled, float x, float y, float width, float height, float r, float g, float b,
 		lines& l) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	l.bind_buffer();
@@ -697,6 +779,7 @@ void render_linegraph(sys::state const& state, color_modification enabled, float
 }
 
 void render_linegraph(sys::state const& state, color_modification enabled, float x, float y, float width, float height, float r, float g, float b, float a, lines& l) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	l.bind_buffer();
@@ -721,6 +804,7 @@ void render_linegraph(sys::state const& state, color_modification enabled, float
 
 void render_barchart(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
 		data_texture& t, ui::rotation r, bool flipped, bool rtl) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped, rtl);
@@ -738,6 +822,7 @@ void render_barchart(sys::state const& state, color_modification enabled, float
 }
 
 void render_piechart(sys::state const& state, color_modification enabled, float x, float y, float size, data_texture& t) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
@@ -754,6 +839,7 @@ void render_piechart(sys::state const& state, color_modification enabled, float
 	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 }
 void render_stripchart(sys::state const& state, color_modification enabled, float x, float y, float sizex, float sizey, data_texture& t) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	glBindVertexBuffer(0, state.open_gl.global_square_buffer, 0, sizeof(GLfloat) * 4);
@@ -771,6 +857,7 @@ void render_stripchart(sys::state const& state, color_modification enabled, floa
 }
 void render_bordered_rect(sys::state const& state, color_modification enabled, float border_size, float x, float y, float width,
 		float height, GLuint texture_handle, ui::rotation r, bool flipped, bool rtl) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped, rtl);
@@ -790,6 +877,7 @@ void render_bordered_rect(sys::state const& state, color_modification enabled, f
 
 void render_masked_rect(sys::state const& state, color_modification enabled, float x, float y, float width, float height,
 		GLuint texture_handle, GLuint mask_texture_handle, ui::rotation r, bool flipped, bool rtl) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped, rtl);
@@ -810,6 +898,7 @@ void render_masked_rect(sys::state const& state, color_modification enabled, flo
 
 void render_progress_bar(sys::state const& state, color_modification enabled, float progress, float x, float y, float width,
 		float height, GLuint left_texture_handle, GLuint right_texture_handle, ui::rotation r, bool flipped, bool rtl) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped, rtl);
@@ -831,6 +920,7 @@ void render_progress_bar(sys::state const& state, color_modification enabled, fl
 
 void render_tinted_textured_rect(sys::state const& state, float x, float y, float width, float height, float r, float g, float b,
 		GLuint texture_handle, ui::rotation rot, bool flipped, bool rtl) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, rot, flipped, rtl);
@@ -854,6 +944,7 @@ void render_tinted_rect(
 	float r, float g, float b,
 	ui::rotation rot, bool flipped, bool rtl
 ) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 	bind_vertices_by_rotation(state, rot, flipped, rtl);
 	glUniform3f(state.open_gl.ui_shader_inner_color_uniform, r, g, b);
@@ -866,6 +957,7 @@ void render_tinted_rect(
 void render_tinted_subsprite(sys::state const& state, int frame, int total_frames, float x, float y,
 		float width, float height, float r, float g, float b, GLuint texture_handle, ui::rotation rot, bool flipped,
 		bool rtl) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, rot, flipped, rtl);
@@ -887,6 +979,7 @@ void render_tinted_subsprite(sys::state const& state, int frame, int total_frame
 
 void render_subsprite(sys::state const& state, color_modification enabled, int frame, int total_frames, float x, float y,
 		float width, float height, GLuint texture_handle, ui::rotation r, bool flipped, bool rtl) {
+	flush_ui_batch(state);
 	glBindVertexArray(state.open_gl.global_square_vao);
 
 	bind_vertices_by_rotation(state, r, flipped, rtl);
@@ -947,6 +1040,7 @@ bool display_tag_is_valid(sys::state& state, char tag[3]) {
 }
 
 void render_text_icon(sys::state& state, text::embedded_icon ico, float x, float baseline_y, float font_size, text::font& f, ogl::color_modification cmod) {
+	flush_ui_batch(state);
 	float scale = 1.f;
 	float icon_baseline = baseline_y + (f.internal_ascender / 64.f * font_size) - font_size;
 
@@ -986,6 +1080,7 @@ void render_text_icon(sys::state& state, text::embedded_icon ico, float x, float
 }
 
 void render_text_flag(sys::state& state, text::embedded_flag ico, float x, float baseline_y, float font_size, text::font& f, ogl::color_modification cmod) {
+	flush_ui_batch(state);
 	float icon_baseline = baseline_y + (f.internal_ascender / 64.f * font_size) - font_size;
 
 	auto fat_id = dcon::fatten(state.world, ico.tag);
@@ -1114,6 +1209,7 @@ void internal_text_render(sys::state& state, text::stored_glyphs const& txt, flo
 }
 
 void render_classic_text(sys::state& state, text::stored_glyphs const& txt, float x, float y, float size, color_modification enabled, color3f const& c, text::bm_font const& font, text::font& base_font) {
+	flush_ui_batch(state);
 	std::string codepoints = "";
 	for(uint32_t i = 0; i < uint32_t(txt.glyph_info.size()); i++) {
 		codepoints.push_back(char(txt.glyph_info[i].codepoint));
@@ -1165,6 +1261,34 @@ void render_classic_text(sys::state& state, text::stored_glyphs const& txt, floa
 }
 
 void render_new_text(sys::state& state, text::stored_glyphs const& txt, color_modification enabled, float x, float y, float size, color3f const& c, text::font& f) {
+	if(state.open_gl.ui_sprites.active) {
+		ui_batch_key key;
+		key.coloring = map_color_modification_to_index(ogl::color_modification::none);
+		key.filter = parameters::filter;
+		key.r = c.r;
+		key.g = c.g;
+		key.b = c.b;
+		key.border_size = 0.08f * 16.0f / size;
+
+		float baseline_y = y + size;
+		GLfloat square[16];
+		unsigned int glyph_count = static_cast<unsigned int>(txt.glyph_info.size());
+		for(unsigned int i = 0; i < glyph_count; i++) {
+			hb_codepoint_t glyphid = txt.glyph_info[i].codepoint;
+			auto gso = f.glyph_positions[glyphid];
+			float x_advance = float(txt.glyph_info[i].x_advance) / (float((1 << 6) * text::magnification_factor));
+			float x_offset = float(txt.glyph_info[i].x_offset) / (float((1 << 6) * text::magnification_factor)) + float(gso.x);
+			float y_offset = float(gso.y) - float(txt.glyph_info[i].y_offset) / (float((1 << 6) * text::magnification_factor));
+			assert(uint32_t(gso.texture_slot >> 6) < f.textures.size());
+			key.texture = f.textures[gso.texture_slot >> 6];
+			fill_sub_square(gso.texture_slot & 63, square);
+			state.open_gl.ui_sprites.record(key, x + x_offset * size / 64.f, baseline_y + y_offset * size / 64.f, size, size, square);
+			x += x_advance * size / 64.f;
+			baseline_y -= (float(txt.glyph_info[i].y_advance) / (float((1 << 6) * text::magnification_factor))) * size / 64.f;
+		}
+		return;
+	}
+
 	glUniform3f(state.open_gl.ui_shader_inner_color_uniform, c.r, c.g, c.b);
 	glUniform1f(state.open_gl.ui_shader_border_size_uniform, 0.08f * 16.0f / size);
 	internal_text_render(state, txt, x, y + size, size, f);
@@ -1306,6 +1430,7 @@ GLuint load_texture_array_from_file(simple_fs::file& file, int32_t tiles_x, int3
 }
 
 void render_capture::ready(sys::state& state) {
+	flush_ui_batch(state);
 	if(state.x_size > max_x || state.y_size > max_y) {
 		max_x = std::max(max_x, state.x_size);
 		max_y = std::max(max_y, state.y_size);
@@ -1359,6 +1484,7 @@ void render_capture::ready(sys::state& state) {
 	}
 }
 void render_capture::finish(sys::state& state) {
+	flush_ui_batch(state);
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 GLuint render_capture::get() {
@@ -1371,6 +1497,7 @@ render_capture::~render_capture() {
 		glDeleteFramebuffers(1, &framebuffer);
 }
 void render_subrect(sys::state const& state, float target_x, float target_y, float target_width, float target_height, float source_x, float source_y, float source_width, float source_height, GLuint texture_handle) {
+	flush_ui_batch(state);
 	bind_vertices_by_rotation(state, ui::rotation::upright, false, false);
 	GLuint subroutines[2] = { parameters::enabled, parameters::subsprite_c };
 	glUniform2ui(state.open_gl.ui_shader_subroutines_index_uniform, subroutines[0], subroutines[1]);
@@ -1407,6 +1534,7 @@ void animation::post_update_frame(sys::state& state) {
 	}
 }
 void animation::render(sys::state& state) {
+	flush_ui_batch(state);
 	if(!running)
 		return;
 	auto entry_time = std::chrono::steady_clock::now();
@@ -11,6 +11,7 @@
 #include "container_types.hpp"
 #include "texture.hpp"
 #include "fonts.hpp"
+#include "ui_batch.hpp"
 
 namespace ogl {
 namespace parameters {
@@ -204,6 +205,7 @@ inline void debug_callback(GLenum source, GLenum type, GLuint id, GLenum severit
 struct data {
 	tagged_vector<texture, dcon::texture_id> asset_textures;
 	ankerl::unordered_dense::map<std::string, dcon::texture_id> late_loaded_map;
+	texture_decoder decoder;
 
 	void* context = nullptr;
 	bool legacy_mode = false;
@@ -241,6 +243,9 @@ struct data {
 
 	GLuint sub_square_buffers[64] = {0};
 
+	GLuint ui_batch_buffer = 0;
+	mutable ui_batch ui_sprites; // recorded into by the const render functions
+
 	GLuint money_icon_tex = 0;
 	GLuint cross_icon_tex = 0;
 	GLuint color_blind_cross_icon_tex = 0;
@@ -311,6 +316,12 @@ public:
 
 std::string_view framebuffer_error(GLenum e);
 
+// while a ui batch is open, textured rects and glyphs are recorded and drawn together by the next flush
+// every other draw flushes first, so the painter's order is kept
+void begin_ui_batch(sys::state const& state);
+void flush_ui_batch(sys::state const& state);
+void end_ui_batch(sys::state const& state);
+
 void render_colored_rect(sys::state const& state, float x, float y, float width, float height, float red, float green, float blue, ui::rotation r, bool flipped, bool rtl);
 void render_alpha_colored_rect(sys::state const& state, float x, float y, float width, float height, float red, float green, float blue, float alpha);
 void render_simple_rect(sys::state const& state, float x, float y, float width, float height, ui::rotation r, bool flipped, bool rtl);
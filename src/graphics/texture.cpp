@@ -1,6 +1,7 @@
 #include "texture.hpp"
 #include "system_state.hpp"
 #include "simple_fs.hpp"
+#include <algorithm>
 
 #define STB_IMAGE_IMPLEMENTATION 1
 #define STBI_NO_STDIO 1
@@ -769,6 +770,123 @@ set to one or more of the following values.	*/
 		return 0;
 	}
 
+decoded_image::decoded_image(decoded_image&& other) noexcept {
+	data = other.data;
+	size_x = other.size_x;
+	size_y = other.size_y;
+
+	other.data = nullptr;
+}
+decoded_image& decoded_image::operator=(decoded_image&& other) noexcept {
+	if(this != &other) {
+		STBI_FREE(data);
+		data = other.data;
+		size_x = other.size_x;
+		size_y = other.size_y;
+
+		other.data = nullptr;
+	}
+	return *this;
+}
+decoded_image::~decoded_image() {
+	STBI_FREE(data);
+	data = nullptr;
+}
+
+decoded_image decode_image(uint8_t const* buffer, size_t size) {
+	decoded_image result;
+	int32_t file_channels = 4;
+	result.data = stbi_load_from_memory(buffer, int32_t(size), &(result.size_x), &(result.size_y), &file_channels, 4);
+	if(!result.data) {
+		result.size_x = 0;
+		result.size_y = 0;
+	}
+	return result;
+}
+
+texture_decode_result decode_texture_files(simple_fs::file_system const& fs, texture_decode_request const& request) {
+	texture_decode_result result;
+	result.id = request.id;
+
+	auto root = get_root(fs);
+	for(auto& native_name : request.candidates) {
+		auto file = open_file(root, native_name);
+		if(!file && native_name.length() > 4) {
+			auto png_name = native_name;
+			if(auto pos = png_name.find_last_of('.'); pos != native_string::npos) {
+				png_name[pos + 1] = NATIVE('p');
+				png_name[pos + 2] = NATIVE('n');
+				png_name[pos + 3] = NATIVE('g');
+				png_name.resize(pos + 4);
+			}
+			file = open_file(root, png_name);
+		}
+		if(file) {
+			auto content = simple_fs::view_contents(*file);
+			result.image = decode_image(reinterpret_cast<uint8_t const*>(content.data), size_t(content.file_size));
+			if(result.image.data)
+				break;
+		}
+	}
+	return result;
+}
+
+texture_decoder::~texture_decoder() {
+	{
+		std::lock_guard lock{ queue_lock };
+		stopping = true;
+	}
+	queue_signal.notify_all();
+	for(auto& w : workers) {
+		w.join();
+	}
+}
+
+void texture_decoder::request(simple_fs::file_system const& file_system, texture_decode_request&& r) {
+	{
+		std::lock_guard lock{ queue_lock };
+		fs = &file_system;
+		requests.push_back(std::move(r));
+	}
+	if(workers.empty()) {
+		auto count = std::clamp(std::thread::hardware_concurrency() / 4u, 1u, 4u);
+		for(uint32_t i = 0; i < count; ++i) {
+			workers.emplace_back([this]() { worker_loop(); });
+		}
+	}
+	queue_signal.notify_one();
+}
+
+void texture_decoder::worker_loop() {
+	while(true) {
+		texture_decode_request r;
+		simple_fs::file_system const* file_system = nullptr;
+		{
+			std::unique_lock lock{ queue_lock };
+			queue_signal.wait(lock, [&]() { return stopping || !requests.empty(); });
+			if(stopping)
+				return;
+			r = std::move(requests.front());
+			requests.pop_front();
+			file_system = fs;
+		}
+		auto result = decode_texture_files(*file_system, r);
+		{
+			std::lock_guard lock{ queue_lock };
+			results.push_back(std::move(result));
+		}
+	}
+}
+
+bool texture_decoder::pop_result(texture_decode_result& out) {
+	std::lock_guard lock{ queue_lock };
+	if(results.empty())
+		return false;
+	out = std::move(results.front());
+	results.pop_front();
+	return true;
+}
+
 texture::~texture() {
 	STBI_FREE(data);
 	data = nullptr;
@@ -777,6 +895,7 @@ texture::~texture() {
 texture::texture(texture&& other) noexcept {
 	channels = other.channels;
 	loaded = other.loaded;
+	decode_requested = other.decode_requested;
 	size_x = other.size_x;
 	size_y = other.size_y;
 	data = other.data;
@@ -787,6 +906,7 @@ texture::texture(texture&& other) noexcept {
 texture& texture::operator=(texture&& other) noexcept {
 	channels = other.channels;
 	loaded = other.loaded;
+	decode_requested = other.decode_requested;
 	size_x = other.size_x;
 	size_y = other.size_y;
 	data = other.data;
@@ -892,27 +1012,79 @@ native_string flag_type_to_name(sys::state& state, dcon::government_flag_id type
 	return NATIVE("");
 }
 
-GLuint get_flag_handle(sys::state& state, dcon::national_identity_id nat_id, dcon::government_flag_id type) {
-	auto masq_nat_id = state.world.nation_get_masquerade_identity(state.world.national_identity_get_nation_from_identity_holder(nat_id));
-	if(!masq_nat_id) {
-		masq_nat_id = nat_id;
-	}
-
+static dcon::texture_id flag_texture_id(sys::state& state, dcon::national_identity_id nat_id, dcon::government_flag_id type) {
 	int flag_offset = 0;
 	if(type) {
 		flag_offset = (int)type.index();
 	}
 
-	dcon::texture_id id = dcon::texture_id{
+	return dcon::texture_id{
 		dcon::texture_id::value_base_t(
 			state.ui_defs.textures.size()
-			+ (1 + masq_nat_id.id.index())
+			+ (1 + nat_id.id.index())
 			* state.world.government_flag_size()
 			+ flag_offset
 		)
 	};
+}
 
-	if(state.open_gl.asset_textures[id].loaded) {
+static bool has_dds_variant(simple_fs::directory const& root, native_string const& native_name) {
+	if(native_name.length() <= 4)
+		return false;
+	auto dds_name = native_name;
+	if(auto pos = dds_name.find_last_of('.'); pos != native_string::npos) {
+		dds_name[pos + 1] = NATIVE('d');
+		dds_name[pos + 2] = NATIVE('d');
+		dds_name[pos + 3] = NATIVE('s');
+		dds_name.resize(pos + 4);
+	}
+	return bool(open_file(root, dds_name));
+}
+
+// hands out a transparent placeholder right away and queues the decode; the image replaces the placeholder's
+// contents once it is uploaded, so callers that store the handle pick it up without asking again
+static GLuint request_decoded_texture(sys::state& state, dcon::texture_id id, std::vector<native_string>&& candidates) {
+	auto& asset_texture = state.open_gl.asset_textures[id];
+	if(asset_texture.loaded || asset_texture.decode_requested)
+		return asset_texture.texture_handle;
+
+	// dds files are decoded by the gl driver, so they keep going through the synchronous loader
+	auto root = get_root(state.common_fs);
+	for(auto& name : candidates) {
+		if(has_dds_variant(root, name)) {
+			for(auto& n : candidates) {
+				if(auto handle = load_file_and_return_handle(n, state.common_fs, asset_texture, false); handle)
+					return handle;
+			}
+			return 0;
+		}
+	}
+
+	glGenTextures(1, &asset_texture.texture_handle);
+	if(asset_texture.texture_handle) {
+		uint32_t transparent = 0;
+		glBindTexture(GL_TEXTURE_2D, asset_texture.texture_handle);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &transparent);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+	asset_texture.decode_requested = true;
+	state.open_gl.decoder.request(state.common_fs, texture_decode_request{ id, std::move(candidates) });
+	return asset_texture.texture_handle;
+}
+
+GLuint get_flag_handle(sys::state& state, dcon::national_identity_id nat_id, dcon::government_flag_id type) {
+	auto masq_nat_id = state.world.nation_get_masquerade_identity(state.world.national_identity_get_nation_from_identity_holder(nat_id));
+	if(!masq_nat_id) {
+		masq_nat_id = nat_id;
+	}
+
+	dcon::texture_id id = flag_texture_id(state, masq_nat_id, type);
+
+	if(state.open_gl.asset_textures[id].loaded || state.open_gl.asset_textures[id].decode_requested) {
 		return state.open_gl.asset_textures[id].texture_handle;
 	} else { // load from file
 		native_string file_str;
@@ -923,17 +1095,41 @@ GLuint get_flag_handle(sys::state& state, dcon::national_identity_id nat_id, dco
 		file_str += simple_fs::win1250_to_native(nations::int_to_tag(state.world.national_identity_get_identifying_int(masq_nat_id)));
 		native_string default_file_str = file_str;
 		file_str += flag_type_to_name(state, type);
-		GLuint p_tex = load_file_and_return_handle(file_str + NATIVE(".png"), state.common_fs, state.open_gl.asset_textures[id], false);
-		if(!p_tex) {
-			p_tex = load_file_and_return_handle(file_str + NATIVE(".tga"), state.common_fs, state.open_gl.asset_textures[id], false);
-			if(!p_tex) {
-				p_tex = load_file_and_return_handle(default_file_str + NATIVE(".png"), state.common_fs, state.open_gl.asset_textures[id], false);
-				if(!p_tex) {
-					return load_file_and_return_handle(default_file_str + NATIVE(".tga"), state.common_fs, state.open_gl.asset_textures[id], false);
-				}
-			}
+		return request_decoded_texture(state, id, std::vector<native_string>{
+			file_str + NATIVE(".png"),
+			file_str + NATIVE(".tga"),
+			default_file_str + NATIVE(".png"),
+			default_file_str + NATIVE(".tga") });
+	}
+}
+
+void prefetch_flag_handles(sys::state& state) {
+	for(auto n : state.world.in_nation) {
+		if(n.get_owned_province_count() != 0) {
+			get_flag_handle(state, n.get_identity_from_identity_holder(), culture::get_current_flag_type(state, n.id));
 		}
-		return p_tex;
+	}
+}
+
+void upload_decoded_textures(sys::state& state) {
+	size_t uploaded_bytes = 0;
+	texture_decode_result result;
+	while(uploaded_bytes < max_texture_upload_bytes_per_frame && state.open_gl.decoder.pop_result(result)) {
+		auto& asset_texture = state.open_gl.asset_textures[result.id];
+		asset_texture.loaded = true;
+		asset_texture.decode_requested = false;
+		if(!result.image.data)
+			continue; // nothing could be decoded, the placeholder stays
+
+		asset_texture.channels = 4;
+		asset_texture.size_x = result.image.size_x;
+		asset_texture.size_y = result.image.size_y;
+
+		glBindTexture(GL_TEXTURE_2D, asset_texture.texture_handle);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, result.image.size_x, result.image.size_y, 0, GL_RGBA, GL_UNSIGNED_BYTE, result.image.data);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		uploaded_bytes += size_t(4) * size_t(result.image.size_x) * size_t(result.image.size_y);
 	}
 }
 
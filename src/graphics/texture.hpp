@@ -7,6 +7,10 @@
 #endif
 #include "glew.h"
 #include "culture.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 namespace dcon {
 class government_flag_id;
@@ -23,6 +27,8 @@ GLuint get_rebel_flag_handle(sys::state& state, dcon::rebel_faction_id faction);
 GLuint get_rebel_flag_overlay(sys::state& state);
 GLuint load_file_and_return_handle(native_string const& native_name, simple_fs::file_system const& fs, texture& asset_texture, bool keep_data);
 GLuint get_late_load_texture_handle(sys::state& state, dcon::texture_id& id, std::string_view asset_name);
+void prefetch_flag_handles(sys::state& state);
+void upload_decoded_textures(sys::state& state);
 
 enum {
 	SOIL_FLAG_TEXTURE_REPEATS = 4,
@@ -40,6 +46,7 @@ public:
 	int32_t channels = 4;
 
 	bool loaded = false;
+	bool decode_requested = false; // the handle is a placeholder until the decoded image is uploaded
 
 	texture() { }
 	texture(texture const&) = delete;
@@ -59,6 +66,58 @@ public:
 	friend GLuint get_late_load_texture_handle(sys::state& state, dcon::texture_id& id, std::string_view asset_name);
 };
 
+// rgba8 pixels decoded on the cpu, ready to be uploaded
+struct decoded_image {
+	uint8_t* data = nullptr;
+	int32_t size_x = 0;
+	int32_t size_y = 0;
+
+	decoded_image() { }
+	decoded_image(decoded_image const&) = delete;
+	decoded_image(decoded_image&& other) noexcept;
+	~decoded_image();
+
+	decoded_image& operator=(decoded_image const&) = delete;
+	decoded_image& operator=(decoded_image&& other) noexcept;
+};
+
+decoded_image decode_image(uint8_t const* buffer, size_t size);
+
+struct texture_decode_request {
+	dcon::texture_id id;
+	std::vector<native_string> candidates; // tried in order, the first one that decodes wins
+};
+struct texture_decode_result {
+	dcon::texture_id id;
+	decoded_image image;
+};
+
+texture_decode_result decode_texture_files(simple_fs::file_system const& fs, texture_decode_request const& request);
+
+// png and tga files are decoded by a small pool of workers; the render thread picks up the results
+class texture_decoder {
+	std::vector<std::thread> workers;
+	std::mutex queue_lock;
+	std::condition_variable queue_signal;
+	std::deque<texture_decode_request> requests;
+	std::deque<texture_decode_result> results;
+	simple_fs::file_system const* fs = nullptr;
+	bool stopping = false;
+
+	void worker_loop();
+
+public:
+	texture_decoder() { }
+	texture_decoder(texture_decoder const&) = delete;
+	texture_decoder& operator=(texture_decoder const&) = delete;
+	~texture_decoder();
+
+	void request(simple_fs::file_system const& file_system, texture_decode_request&& r);
+	bool pop_result(texture_decode_result& out);
+};
+
+inline constexpr size_t max_texture_upload_bytes_per_frame = 4 * 1024 * 1024;
+
 class data_texture {
 	GLuint texture_handle = 0;
 
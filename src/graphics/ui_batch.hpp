@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ogl {
+
+// everything the ui shader needs besides the quad itself
+struct ui_batch_key {
+	uint32_t texture = 0;
+	uint32_t coloring = 0;
+	uint32_t filter = 0;
+	float r = 0.0f;
+	float g = 0.0f;
+	float b = 0.0f;
+	float border_size = 0.0f;
+
+	bool operator==(ui_batch_key const& o) const {
+		return texture == o.texture && coloring == o.coloring && filter == o.filter && r == o.r && g == o.g && b == o.b && border_size == o.border_size;
+	}
+};
+
+struct ui_batch_vertex {
+	float x = 0.0f;
+	float y = 0.0f;
+	float u = 0.0f;
+	float v = 0.0f;
+};
+
+struct ui_batch_quad {
+	ui_batch_vertex corners[4];
+	uint32_t run = 0;
+};
+
+struct ui_batch_run {
+	ui_batch_key key;
+	// bounding box of everything in the run, used to decide whether later quads may be drawn earlier
+	float left = 0.0f;
+	float top = 0.0f;
+	float right = 0.0f;
+	float bottom = 0.0f;
+	uint32_t first = 0; // in vertices, valid after build
+	uint32_t count = 0; // in vertices
+
+	bool overlaps(float x, float y, float width, float height) const {
+		return x < right && left < x + width && y < bottom && top < y + height;
+	}
+};
+
+inline constexpr uint32_t ui_batch_look_back = 8;
+
+class ui_batch {
+public:
+	std::vector<ui_batch_quad> quads;
+	std::vector<ui_batch_run> runs;
+	std::vector<ui_batch_vertex> vertices;
+	bool active = false;
+
+	// square holds four (position, texture coordinate) corners in fan order, as in the global square buffers
+	void record(ui_batch_key const& key, float x, float y, float width, float height, float const* square) {
+		// a quad may join an earlier run with the same state as long as nothing recorded since then overlaps it
+		uint32_t target = uint32_t(runs.size());
+		for(uint32_t i = uint32_t(runs.size()); i-- > 0 && uint32_t(runs.size()) - i <= ui_batch_look_back; ) {
+			if(runs[i].key == key) {
+				target = i;
+				break;
+			}
+			if(runs[i].overlaps(x, y, width, height))
+				break;
+		}
+		if(target == uint32_t(runs.size())) {
+			runs.push_back(ui_batch_run{ key, x, y, x + width, y + height, 0, 0 });
+		} else {
+			auto& run = runs[target];
+			run.left = std::min(run.left, x);
+			run.top = std::min(run.top, y);
+			run.right = std::max(run.right, x + width);
+			run.bottom = std::max(run.bottom, y + height);
+		}
+		runs[target].count += 6;
+
+		ui_batch_quad q;
+		for(uint32_t i = 0; i < 4; ++i) {
+			q.corners[i].x = x + square[i * 4 + 0] * width;
+			q.corners[i].y = y + square[i * 4 + 1] * height;
+			q.corners[i].u = square[i * 4 + 2];
+			q.corners[i].v = square[i * 4 + 3];
+		}
+		q.run = target;
+		quads.push_back(q);
+	}
+
+	// lays the quads out as triangles, contiguous per run, keeping recording order within a run
+	void build() {
+		uint32_t offset = 0;
+		for(auto& run : runs) {
+			run.first = offset;
+			offset += run.count;
+		}
+		vertices.resize(offset);
+		std::vector<uint32_t> next(runs.size());
+		for(uint32_t i = 0; i < uint32_t(runs.size()); ++i) {
+			next[i] = runs[i].first;
+		}
+		for(auto& q : quads) {
+			auto out = vertices.data() + next[q.run];
+			out[0] = q.corners[0];
+			out[1] = q.corners[1];
+			out[2] = q.corners[2];
+			out[3] = q.corners[0];
+			out[4] = q.corners[2];
+			out[5] = q.corners[3];
+			next[q.run] += 6;
+		}
+	}
+
+	void clear() {
+		quads.clear();
+		runs.clear();
+		vertices.clear();
+	}
+	bool empty() const {
+		return quads.empty();
+	}
+};
+
+} // namespace ogl
@@ -6,6 +6,7 @@
 #include "demographics.hpp"
 #include "economy_pops.hpp"
 #include "advanced_province_buildings.hpp"
+#include "widgets/table.hpp"
 
 #include "macrobuilder2.cpp"
 #include "budgetwindow.cpp"
@@ -2321,5 +2322,108 @@ void pop_screen_sort_state_rows(sys::state& state, std::vector<dcon::state_insta
 	}
 }
 
+// ranks the names of every id below count so that comparing ranks is the same as comparing names
+template<typename F>
+static std::vector<float> rank_entity_names(uint32_t count, F&& name_of) {
+	std::vector<std::string> names;
+	names.reserve(count);
+	for(uint32_t i = 0; i < count; ++i) {
+		names.push_back(name_of(i));
+	}
+	return ::table::rank_names(names);
+}
+
+template<typename T>
+static float rank_of(std::vector<float> const& ranks, T id) {
+	return id ? ranks[id.index()] : -1.0f;
+}
+
+void pop_screen_sort_pop_rows(sys::state& state, alice_ui::demographicswindow_main_table_t& table, alice_ui::layout_window_element* parent) {
+	using pop_row = alice_ui::demographicswindow_main_table_t::pop_row_option;
+	auto table_source = (alice_ui::demographicswindow_main_t*)(parent);
+	// the generated sorts apply the columns in this order, so the last one is the most significant
+	int8_t const directions[11] = {
+		table_source->table_needs_sort_direction,
+		table_source->table_money_sort_direction,
+		table_source->table_literacy_sort_direction,
+		table_source->table_employment_sort_direction,
+		table_source->table_consciousness_sort_direction,
+		table_source->table_militancy_sort_direction,
+		table_source->table_religion_sort_direction,
+		table_source->table_job_sort_direction,
+		table_source->table_culture_sort_direction,
+		table_source->table_size_sort_direction,
+		table_source->table_location_sort_direction,
+	};
+	if(std::all_of(std::begin(directions), std::end(directions), [](int8_t d) { return d == 0; })) {
+		table.pop_order.invalidate();
+		return;
+	}
+
+	// names are looked up once per entity instead of twice per comparison
+	std::vector<float> religion_ranks;
+	std::vector<float> job_ranks;
+	std::vector<float> culture_ranks;
+	std::vector<float> location_ranks;
+	if(directions[6] != 0) {
+		religion_ranks = rank_entity_names(state.world.religion_size(), [&](uint32_t i) {
+			return text::produce_simple_string(state, state.world.religion_get_name(dcon::religion_id{ dcon::religion_id::value_base_t(i) }));
+		});
+	}
+	if(directions[7] != 0) {
+		job_ranks = rank_entity_names(state.world.pop_type_size(), [&](uint32_t i) {
+			return text::produce_simple_string(state, state.world.pop_type_get_name(dcon::pop_type_id{ dcon::pop_type_id::value_base_t(i) }));
+		});
+	}
+	if(directions[8] != 0) {
+		culture_ranks = rank_entity_names(state.world.culture_size(), [&](uint32_t i) {
+			return text::produce_simple_string(state, state.world.culture_get_name(dcon::culture_id{ dcon::culture_id::value_base_t(i) }));
+		});
+	}
+	if(directions[10] != 0) {
+		location_ranks = rank_entity_names(state.world.province_size(), [&](uint32_t i) {
+			return text::produce_simple_string(state, state.world.province_get_name(dcon::province_id{ dcon::province_id::value_base_t(i) }));
+		});
+	}
+
+	std::vector<dcon::pop_id> pops;
+	std::vector<size_t> slots;
+	std::vector<alice_ui::pop_row_sort_key> keys;
+	uint32_t run = 0;
+	for(size_t i = 0; i < table.values.size(); ++i) {
+		if(!std::holds_alternative<pop_row>(table.values[i])) {
+			++run;
+			continue;
+		}
+		auto p = std::get<pop_row>(table.values[i]).value;
+		alice_ui::pop_row_sort_key key;
+		key.run = run;
+		auto set = [&](int32_t column, auto&& value_of) {
+			if(directions[column] != 0)
+				key.values[column] = float(directions[column]) * value_of();
+		};
+		set(0, [&]() { return pop_demographics::get_life_needs(state, p) + pop_demographics::get_everyday_needs(state, p) + pop_demographics::get_luxury_needs(state, p); });
+		set(1, [&]() { return state.world.pop_get_savings(p); });
+		set(2, [&]() { return pop_demographics::get_literacy(state, p); });
+		set(3, [&]() { return pop_demographics::get_employment(state, p); });
+		set(4, [&]() { return pop_demographics::get_consciousness(state, p); });
+		set(5, [&]() { return pop_demographics::get_militancy(state, p); });
+		set(6, [&]() { return rank_of(religion_ranks, state.world.pop_get_religion(p)); });
+		set(7, [&]() { return rank_of(job_ranks, state.world.pop_get_poptype(p)); });
+		set(8, [&]() { return rank_of(culture_ranks, state.world.pop_get_culture(p)); });
+		set(9, [&]() { return state.world.pop_get_size(p); });
+		set(10, [&]() { return rank_of(location_ranks, state.world.pop_get_province_from_pop_location(p)); });
+		pops.push_back(p);
+		slots.push_back(i);
+		keys.push_back(key);
+	}
+
+	// keys are ordered by run first, so every pop is written back into a slot of its own run
+	auto const& order = table.pop_order.update(pops, std::move(keys));
+	for(size_t i = 0; i < slots.size(); ++i) {
+		table.values[slots[i]] = pop_row{ pops[order[i]] };
+	}
+}
+
 
 }
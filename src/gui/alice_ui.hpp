@@ -235,6 +235,21 @@ std::unique_ptr<ui::element_base> make_pop_details_main(sys::state& state);
 
 void pop_screen_sort_state_rows(sys::state& state, std::vector<dcon::state_instance_id>& state_instances, alice_ui::layout_window_element* parent);
 
+// the run of consecutive pop rows a pop belongs to, then one value per sort column with the one applied last first
+struct pop_row_sort_key {
+	uint32_t run = 0;
+	std::array<float, 11> values{};
+
+	bool operator==(pop_row_sort_key const& o) const {
+		return run == o.run && values == o.values;
+	}
+	bool operator<(pop_row_sort_key const& o) const {
+		return run < o.run || (run == o.run && values < o.values);
+	}
+};
+struct demographicswindow_main_table_t;
+void pop_screen_sort_pop_rows(sys::state& state, alice_ui::demographicswindow_main_table_t& table, alice_ui::layout_window_element* parent);
+
 inline int8_t cmp3(std::string_view a, std::string_view b) {
 	return int8_t(std::clamp(a.compare(b), -1, 1));
 }
@@ -2494,15 +2494,15 @@ void budgetwindow_main_income_amount_t::render(sys::state & state, int32_t x, in
 void budgetwindow_main_income_amount_t::on_update(sys::state& state) noexcept {
 	budgetwindow_main_t& main = *((budgetwindow_main_t*)(parent)); 
 // BEGIN main::income_amount::update
+	auto& est = economy::cached_budget_estimates(state, state.local_player_nation);
 	float total = 0.0f;
-	total += economy::estimate_diplomatic_income(state, state.local_player_nation);
-	auto tax_info = economy::explain_tax_income(state, state.local_player_nation);
-	total += tax_info.poor;
-	total += tax_info.mid;
-	total += tax_info.rich;
-	total += economy::estimate_tariff_import_income(state, state.local_player_nation);
-	total += economy::estimate_tariff_export_income(state, state.local_player_nation);
-	total += economy::estimate_gold_income(state, state.local_player_nation);
+	total += est.diplomatic_income;
+	total += est.poor_tax;
+	total += est.mid_tax;
+	total += est.rich_tax;
+	total += est.tariff_import_income;
+	total += est.tariff_export_income;
+	total += est.gold_income;
 	set_text(state, text::prettify_currency(total));
 // END
 }
@@ -2572,20 +2572,21 @@ void budgetwindow_main_expenses_amount_t::render(sys::state & state, int32_t x,
 void budgetwindow_main_expenses_amount_t::on_update(sys::state& state) noexcept {
 	budgetwindow_main_t& main = *((budgetwindow_main_t*)(parent)); 
 // BEGIN main::expenses_amount::update
+	auto& est = economy::cached_budget_estimates(state, state.local_player_nation);
 	float total = 0.0f;
-	total += economy::estimate_diplomatic_expenses(state, state.local_player_nation); 
-	total += economy::estimate_social_spending(state, state.local_player_nation);
-	total += economy::estimate_pop_payouts_by_income_type(state, state.local_player_nation, culture::income_type::military) * float(state.world.nation_get_military_spending(state.local_player_nation)) * float(state.world.nation_get_military_spending(state.local_player_nation)) / 10000.0f;
-	total += economy::estimate_education_spending(state, state.local_player_nation);
-	total += economy::estimate_spendings_administration(state, state.local_player_nation, float(state.world.nation_get_administrative_spending(state.local_player_nation)) / 100.f);
-	total += economy::estimate_max_domestic_investment(state, state.local_player_nation) * float(state.world.nation_get_domestic_investment_spending(state.local_player_nation)) / 100.0f;
-	total += economy::estimate_overseas_penalty_spending(state, state.local_player_nation) * float(state.world.nation_get_overseas_spending(state.local_player_nation)) / 100.0f;
-	total += economy::estimate_subsidy_spending(state, state.local_player_nation);
-	total += economy::estimate_construction_spending(state, state.local_player_nation);
-	total += economy::estimate_land_spending(state, state.local_player_nation) * float(state.world.nation_get_land_spending(state.local_player_nation)) / 100.0f;
-	total += economy::estimate_naval_spending(state, state.local_player_nation) * float(state.world.nation_get_naval_spending(state.local_player_nation)) / 100.0f;
-	total += economy::interest_payment(state, state.local_player_nation);
-	total += economy::estimate_stockpile_filling_spending(state, state.local_player_nation);
+	total += est.diplomatic_expenses;
+	total += est.social_spending;
+	total += est.military_payouts * float(state.world.nation_get_military_spending(state.local_player_nation)) * float(state.world.nation_get_military_spending(state.local_player_nation)) / 10000.0f;
+	total += est.education_spending;
+	total += est.administration_spending;
+	total += est.max_domestic_investment * float(state.world.nation_get_domestic_investment_spending(state.local_player_nation)) / 100.0f;
+	total += est.overseas_penalty_spending * float(state.world.nation_get_overseas_spending(state.local_player_nation)) / 100.0f;
+	total += est.subsidy_spending;
+	total += est.construction_spending;
+	total += est.land_spending * float(state.world.nation_get_land_spending(state.local_player_nation)) / 100.0f;
+	total += est.naval_spending * float(state.world.nation_get_naval_spending(state.local_player_nation)) / 100.0f;
+	total += est.interest_payment;
+	total += est.stockpile_filling_spending;
 	set_text(state, text::prettify_currency(total));
 // END
 }
@@ -5049,27 +5050,28 @@ void budgetwindow_section_header_expand_button_t::on_update(sys::state& state) n
 	budgetwindow_section_header_t& section_header = *((budgetwindow_section_header_t*)(parent)); 
 	budgetwindow_main_t& main = *((budgetwindow_main_t*)(parent->parent)); 
 // BEGIN section_header::expand_button::update
+	auto& est = economy::cached_budget_estimates(state, state.local_player_nation);
 	switch(section_header.section_type) {
-	case budget_categories::diplomatic_income: disabled = (economy::estimate_diplomatic_income(state, state.local_player_nation) <= 0); break;
+	case budget_categories::diplomatic_income: disabled = (est.diplomatic_income <= 0); break;
 	case budget_categories::poor_tax: disabled = false; break;
 	case budget_categories::middle_tax: disabled = false; break;
 	case budget_categories::rich_tax: disabled = false; break;
-	case budget_categories::tariffs_import: disabled = (economy::estimate_tariff_import_income(state, state.local_player_nation) <= 0); break;
-	case budget_categories::tariffs_export: disabled = (economy::estimate_tariff_export_income(state, state.local_player_nation) <= 0); break;
-	case budget_categories::gold: disabled = (economy::estimate_gold_income(state, state.local_player_nation) <= 0); break;
-	case budget_categories::diplomatic_expenses: disabled = (economy::estimate_diplomatic_expenses(state, state.local_player_nation) <= 0); break;
-	case budget_categories::social: disabled = (economy::estimate_social_spending(state, state.local_player_nation) <= 0); break;
+	case budget_categories::tariffs_import: disabled = (est.tariff_import_income <= 0); break;
+	case budget_categories::tariffs_export: disabled = (est.tariff_export_income <= 0); break;
+	case budget_categories::gold: disabled = (est.gold_income <= 0); break;
+	case budget_categories::diplomatic_expenses: disabled = (est.diplomatic_expenses <= 0); break;
+	case budget_categories::social: disabled = (est.social_spending <= 0); break;
 	case budget_categories::military: disabled = false; break;
 	case budget_categories::education: disabled = false; break;
 	case budget_categories::admin: disabled = false; break;
 	case budget_categories::domestic_investment: disabled = false; break;
-	case budget_categories::overseas_spending: disabled = (economy::estimate_overseas_penalty_spending(state, state.local_player_nation) <= 0); break;
-	case budget_categories::subsidies: disabled = (economy::estimate_subsidy_spending(state, state.local_player_nation) <= 0); break;
-	case budget_categories::construction: disabled = (economy::estimate_construction_spending(state, state.local_player_nation) <= 0); break;
-	case budget_categories::army_upkeep: disabled = (economy::estimate_land_spending(state, state.local_player_nation) <= 0); break;
-	case budget_categories::navy_upkeep:disabled = (economy::estimate_naval_spending(state, state.local_player_nation) <= 0); break;
-	case budget_categories::debt_payment: disabled = (economy::interest_payment(state, state.local_player_nation) <= 0); break;
-	case budget_categories::stockpile: disabled = (economy::estimate_stockpile_filling_spending(state, state.local_player_nation) <= 0);  break;
+	case budget_categories::overseas_spending: disabled = (est.overseas_penalty_spending <= 0); break;
+	case budget_categories::subsidies: disabled = (est.subsidy_spending <= 0); break;
+	case budget_categories::construction: disabled = (est.construction_spending <= 0); break;
+	case budget_categories::army_upkeep: disabled = (est.land_spending <= 0); break;
+	case budget_categories::navy_upkeep:disabled = (est.naval_spending <= 0); break;
+	case budget_categories::debt_payment: disabled = (est.interest_payment <= 0); break;
+	case budget_categories::stockpile: disabled = (est.stockpile_filling_spending <= 0);  break;
 	default: disabled = false; break;
 	}
 
@@ -5107,28 +5109,28 @@ void budgetwindow_section_header_total_amount_t::on_update(sys::state& state) no
 	budgetwindow_section_header_t& section_header = *((budgetwindow_section_header_t*)(parent)); 
 	budgetwindow_main_t& main = *((budgetwindow_main_t*)(parent->parent)); 
 // BEGIN section_header::total_amount::update
-	auto info = economy::explain_tax_income(state, state.local_player_nation);
+	auto& est = economy::cached_budget_estimates(state, state.local_player_nation);
 	switch(section_header.section_type) {
-	case budget_categories::diplomatic_income: set_text(state, text::prettify_currency(economy::estimate_diplomatic_income(state, state.local_player_nation))); break;
-	case budget_categories::poor_tax: set_text(state, text::prettify_currency(info.poor)); break;
-	case budget_categories::middle_tax: set_text(state, text::prettify_currency(info.mid)); break;
-	case budget_categories::rich_tax: set_text(state, text::prettify_currency(info.rich)); break;
-	case budget_categories::tariffs_import: set_text(state, text::prettify_currency(economy::estimate_tariff_import_income(state, state.local_player_nation))); break;
-	case budget_categories::tariffs_export: set_text(state, text::prettify_currency(economy::estimate_tariff_export_income(state, state.local_player_nation))); break;
-	case budget_categories::gold: set_text(state, text::prettify_currency(economy::estimate_gold_income(state, state.local_player_nation))); break;
-	case budget_categories::diplomatic_expenses: set_text(state, text::prettify_currency(economy::estimate_diplomatic_expenses(state, state.local_player_nation))); break;
-	case budget_categories::social: set_text(state,  text::prettify_currency(economy::estimate_social_spending(state, state.local_player_nation))); break;
-	case budget_categories::military: set_text(state, text::prettify_currency(economy::estimate_pop_payouts_by_income_type(state, state.local_player_nation, culture::income_type::military) * float(state.world.nation_get_military_spending(state.local_player_nation)) * float(state.world.nation_get_military_spending(state.local_player_nation)) / 10000.0f)); break;
-	case budget_categories::education: set_text(state, text::prettify_currency(economy::estimate_education_spending(state, state.local_player_nation))); break;
-	case budget_categories::admin: set_text(state, text::prettify_currency(economy::estimate_spendings_administration(state, state.local_player_nation, float(state.world.nation_get_administrative_spending(state.local_player_nation)) / 100.f))); break;
-	case budget_categories::domestic_investment: set_text(state, text::prettify_currency(economy::estimate_max_domestic_investment(state, state.local_player_nation) * float(state.world.nation_get_domestic_investment_spending(state.local_player_nation)) / 100.0f)); break;
-	case budget_categories::overseas_spending: set_text(state, text::prettify_currency(economy::estimate_overseas_penalty_spending(state, state.local_player_nation) * float(state.world.nation_get_overseas_spending(state.local_player_nation)) / 100.0f)); break;
-	case budget_categories::subsidies: set_text(state, text::prettify_currency(economy::estimate_subsidy_spending(state, state.local_player_nation))); break;
-	case budget_categories::construction: set_text(state, text::prettify_currency(economy::estimate_construction_spending(state, state.local_player_nation))); break;
-	case budget_categories::army_upkeep: set_text(state, text::prettify_currency(economy::estimate_land_spending(state, state.local_player_nation) * float(state.world.nation_get_land_spending(state.local_player_nation)) / 100.0f)); break;
-	case budget_categories::navy_upkeep: set_text(state, text::prettify_currency(economy::estimate_naval_spending(state, state.local_player_nation) * float(state.world.nation_get_naval_spending(state.local_player_nation)) / 100.0f)); break;
-	case budget_categories::debt_payment: set_text(state, text::prettify_currency(economy::interest_payment(state, state.local_player_nation))); break;
-	case budget_categories::stockpile: set_text(state, text::prettify_currency(economy::estimate_stockpile_filling_spending(state, state.local_player_nation))); break;
+	case budget_categories::diplomatic_income: set_text(state, text::prettify_currency(est.diplomatic_income)); break;
+	case budget_categories::poor_tax: set_text(state, text::prettify_currency(est.poor_tax)); break;
+	case budget_categories::middle_tax: set_text(state, text::prettify_currency(est.mid_tax)); break;
+	case budget_categories::rich_tax: set_text(state, text::prettify_currency(est.rich_tax)); break;
+	case budget_categories::tariffs_import: set_text(state, text::prettify_currency(est.tariff_import_income)); break;
+	case budget_categories::tariffs_export: set_text(state, text::prettify_currency(est.tariff_export_income)); break;
+	case budget_categories::gold: set_text(state, text::prettify_currency(est.gold_income)); break;
+	case budget_categories::diplomatic_expenses: set_text(state, text::prettify_currency(est.diplomatic_expenses)); break;
+	case budget_categories::social: set_text(state,  text::prettify_currency(est.social_spending)); break;
+	case budget_categories::military: set_text(state, text::prettify_currency(est.military_payouts * float(state.world.nation_get_military_spending(state.local_player_nation)) * float(state.world.nation_get_military_spending(state.local_player_nation)) / 10000.0f)); break;
+	case budget_categories::education: set_text(state, text::prettify_currency(est.education_spending)); break;
+	case budget_categories::admin: set_text(state, text::prettify_currency(est.administration_spending)); break;
+	case budget_categories::domestic_investment: set_text(state, text::prettify_currency(est.max_domestic_investment * float(state.world.nation_get_domestic_investment_spending(state.local_player_nation)) / 100.0f)); break;
+	case budget_categories::overseas_spending: set_text(state, text::prettify_currency(est.overseas_penalty_spending * float(state.world.nation_get_overseas_spending(state.local_player_nation)) / 100.0f)); break;
+	case budget_categories::subsidies: set_text(state, text::prettify_currency(est.subsidy_spending)); break;
+	case budget_categories::construction: set_text(state, text::prettify_currency(est.construction_spending)); break;
+	case budget_categories::army_upkeep: set_text(state, text::prettify_currency(est.land_spending * float(state.world.nation_get_land_spending(state.local_player_nation)) / 100.0f)); break;
+	case budget_categories::navy_upkeep: set_text(state, text::prettify_currency(est.naval_spending * float(state.world.nation_get_naval_spending(state.local_player_nation)) / 100.0f)); break;
+	case budget_categories::debt_payment: set_text(state, text::prettify_currency(est.interest_payment)); break;
+	case budget_categories::stockpile: set_text(state, text::prettify_currency(est.stockpile_filling_spending)); break;
 	default: set_text(state, ""); break;
 	}
 // END
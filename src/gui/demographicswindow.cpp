@@ -358,7 +358,7 @@ struct demographicswindow_main_sort_states_toggle_t : public ui::element_base {
 };
 struct demographicswindow_main_table_t : public layout_generator {
 // BEGIN main::table::variables
-// 
+	::table::incremental_order<dcon::pop_id, pop_row_sort_key> pop_order;
 // END
 	struct nation_row_option { dcon::nation_id content; };
 	std::vector<std::unique_ptr<ui::element_base>> nation_row_pool;
@@ -3954,14 +3954,17 @@ void  demographicswindow_main_table_t::update(sys::state& state, layout_window_e
 			bool added_header = false;
 			bool state_is_open = popwindow::open_states.contains(s.index());
 
-			std::vector<dcon::province_id> provs;
-			province::for_each_province_in_state_instance(state, s, [&](dcon::province_id p) { provs.push_back(p); });
+			// resolve each name once instead of twice per comparison
+			std::vector<std::pair<std::string, dcon::province_id>> provs;
+			province::for_each_province_in_state_instance(state, s, [&](dcon::province_id p) {
+				provs.emplace_back(text::produce_simple_string(state, state.world.province_get_name(p)), p);
+			});
 
-			sys::merge_sort(provs.begin(), provs.end(), [&](dcon::province_id a, dcon::province_id b) {
-				return text::produce_simple_string(state, state.world.province_get_name(a)) < text::produce_simple_string(state, state.world.province_get_name(b));
+			sys::merge_sort(provs.begin(), provs.end(), [&](auto const& a, auto const& b) {
+				return a.first < b.first;
 			});
 
-			for(auto p : provs) {
+			for(auto const& [pname, p] : provs) {
 				bool added_pop = false;
 				bool province_is_open = popwindow::open_provs.contains(p.index());
 
@@ -3997,6 +4000,9 @@ void  demographicswindow_main_table_t::update(sys::state& state, layout_window_e
 	if(!popwindow::sort_pops) {
 		return;
 	}
+	// sorts by keys computed once per pop, and only re-sorts the pops whose keys changed since the last update
+	pop_screen_sort_pop_rows(state, *this, parent);
+	return;
 // END
 	{
 	bool work_to_do = false;
@@ -19,8 +19,14 @@ public:
 
 	element_data base_data;
 	element_base* parent = nullptr;
+	uint64_t serial = next_serial(); // unlike the address of the element, never reused by another element
 	uint8_t flags = 0;
 
+	static uint64_t next_serial() {
+		static std::atomic<uint64_t> counter{ 0 };
+		return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
 	bool is_visible() const {
 		return (flags & is_invisible_mask) == 0;
 	}
@@ -448,9 +448,21 @@ public:
 	void render(sys::state& state, int32_t x, int32_t y) noexcept override;
 };
 
+// a tooltip built earlier, reused while neither the game state nor the ui has changed
+struct cached_tooltip {
+	uint64_t element_serial = 0; // see element_base::serial, a destroyed element may leave its address to a new one
+	int32_t sub_index = -1;
+	text::layout contents;
+	xy_pair size;
+	bool visible = false;
+};
+
 class tool_tip : public element_base {
 public:
 	text::layout internal_layout;
+	std::vector<cached_tooltip> cache; // most recently used last
+	std::chrono::time_point<std::chrono::steady_clock> last_build{};
+	bool stale = false; // the game state changed since the shown tooltip was built
 	tool_tip() { }
 	void render(sys::state& state, int32_t x, int32_t y) noexcept override;
 };
@@ -1351,6 +1363,7 @@ message_result listbox_element_base<RowWinT, RowConT>::on_scroll(sys::state& sta
 		amount = is_reversed() ? -amount : amount;
 		list_scrollbar->update_raw_value(state, list_scrollbar->raw_value() + (amount < 0 ? 1 : -1));
 		state.ui_state.last_tooltip = nullptr; //force update of tooltip
+		state.ui_state.tooltip->cache.clear();
 		update(state);
 		return message_result::consumed;
 	}
@@ -1365,6 +1378,7 @@ void listbox_element_base<RowWinT, RowConT>::scroll_to_bottom(sys::state& state)
 	}
 	list_scrollbar->update_raw_value(state, list_size);
 	state.ui_state.last_tooltip = nullptr; //force update of tooltip
+	state.ui_state.tooltip->cache.clear();
 	update(state);
 }
 
@@ -43,7 +43,7 @@ public:
 class topbar_nation_prestige_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, std::to_string(int32_t(nations::prestige_score(state, retrieve<dcon::nation_id>(state, parent)))));
+		set_text(state, std::to_string(int32_t(state.current_ui_snapshot.prestige)));
 	}
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
 		return tooltip_behavior::variable_tooltip;
@@ -54,7 +54,7 @@ public:
 		auto box = text::open_layout_box(contents, 0);
 		text::localised_format_box(state, contents, box, std::string_view("rank_prestige"), text::substitution_map{});
 		text::add_line_break_to_layout_box(state, contents, box);
-		switch(nations::get_status(state, nation_id)) {
+		switch(state.current_ui_snapshot.status) {
 		case(nations::status::great_power):
 			text::localised_format_box(state, contents, box, std::string_view("diplomacy_greatnation_status"), text::substitution_map{});
 			break;
@@ -167,10 +167,12 @@ public:
 	void on_update(sys::state& state) noexcept override {
 		std::vector<float> datapoints(size_t(32));
 
-		if(auto* cache = state.find_player_data_cache(state.local_player_nation)) {
+		auto const& snapshot = state.current_ui_snapshot;
+		if(snapshot.has_records) {
+			auto const* cache = &snapshot.records;
 			for(size_t i = 0; i < (*cache).treasury_record.size(); ++i)
-				datapoints[i] = (*cache).treasury_record[(state.ui_date.value + 1 + i) % 32] - (*cache).treasury_record[(state.ui_date.value + 0 + i) % 32];
-			datapoints[datapoints.size() - 1] = (*cache).treasury_record[(state.ui_date.value + 1 + 31) % 32] - (*cache).treasury_record[(state.ui_date.value + 0 + 31) % 32];
+				datapoints[i] = (*cache).treasury_record[(snapshot.date.value + 1 + i) % 32] - (*cache).treasury_record[(snapshot.date.value + 0 + i) % 32];
+			datapoints[datapoints.size() - 1] = (*cache).treasury_record[(snapshot.date.value + 1 + 31) % 32] - (*cache).treasury_record[(snapshot.date.value + 0 + 31) % 32];
 			datapoints[0] = datapoints[1]; // otherwise you will store the difference between two non-consecutive days here
 			set_data_points(state, datapoints);
 		}
@@ -186,9 +188,7 @@ public:
 	}
 
 	void on_update(sys::state& state) noexcept override {
-		auto n = retrieve<dcon::nation_id>(state, parent);
-		auto literacy = nations::get_avg_non_colonial_literacy(state, n);
-		set_text(state, text::format_percentage(literacy, 1));
+		set_text(state, text::format_percentage(state.current_ui_snapshot.literacy, 1));
 	}
 
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
@@ -196,16 +196,13 @@ public:
 	}
 
 	void update_tooltip(sys::state& state, int32_t x, int32_t y, text::columnar_layout& contents) noexcept override {
-		auto nation_id = retrieve<dcon::nation_id>(state, parent);
-
 		auto box = text::open_layout_box(contents, 0);
 		text::substitution_map sub;
-		auto literacy_change = demographics::get_estimated_literacy_change(state, nation_id);
-		text::add_to_substitution_map(sub, text::variable_type::val, text::fp_percentage_two_places{literacy_change});
-		auto avg_non_colonial_literacy = nations::get_avg_non_colonial_literacy(state, nation_id);
-		text::add_to_substitution_map(sub, text::variable_type::x, text::fp_percentage_one_place{avg_non_colonial_literacy });
+		auto const& snapshot = state.current_ui_snapshot;
+		text::add_to_substitution_map(sub, text::variable_type::val, text::fp_percentage_two_places{ snapshot.literacy_change });
+		text::add_to_substitution_map(sub, text::variable_type::x, text::fp_percentage_one_place{ snapshot.literacy });
 
-		auto avg_literacy = nations::get_avg_total_literacy(state, nation_id);
+		auto avg_literacy = snapshot.total_literacy;
 		text::add_to_substitution_map(sub, text::variable_type::avg, text::fp_percentage_one_place{ avg_literacy });
 
 		text::localised_format_box(state, contents, box, std::string_view("alice_topbar_avg_literacy_in_states"), sub);
@@ -226,7 +223,7 @@ public:
 		expanded_hitbox_text::on_create(state);
 	}
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, text::format_float(state.world.nation_get_infamy(retrieve<dcon::nation_id>(state, parent)), 2));
+		set_text(state, text::format_float(state.current_ui_snapshot.infamy, 2));
 	}
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
 		return tooltip_behavior::variable_tooltip;
@@ -235,11 +232,10 @@ public:
 	void update_tooltip(sys::state& state, int32_t x, int32_t y, text::columnar_layout& contents) noexcept override {
 		auto nation_id = retrieve<dcon::nation_id>(state, parent);
 		auto box = text::open_layout_box(contents, 0);
-		auto fat_id = dcon::fatten(state.world, nation_id);
 		text::localised_format_box(state, contents, box, "infamy");
 		text::add_to_layout_box(state, contents, box, std::string_view(":"));
 		text::add_space_to_layout_box(state, contents, box);
-		text::add_to_layout_box(state, contents, box, text::fp_two_places{fat_id.get_infamy()});
+		text::add_to_layout_box(state, contents, box, text::fp_two_places{ state.current_ui_snapshot.infamy });
 		text::add_to_layout_box(state, contents, box, std::string_view("/"));
 		text::add_to_layout_box(state, contents, box, text::fp_two_places{state.defines.badboy_limit});
 		text::add_line_break_to_layout_box(state, contents, box);
@@ -252,14 +248,15 @@ public:
 class topbar_nation_population_text : public multiline_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		auto n = retrieve<dcon::nation_id>(state, parent);
-		auto total_pop = state.world.nation_get_demographics(n, demographics::total);
+		auto const& snapshot = state.current_ui_snapshot;
+		auto total_pop = snapshot.population;
 
-		if(auto* cache = state.find_player_data_cache(state.local_player_nation)) {
-			auto pop_amount = (*cache).population_record[state.ui_date.value % 32];
-			auto pop_change = state.ui_date.value <= 32
-				? (state.ui_date.value <= 2 ? 0.0f : pop_amount - (*cache).population_record[2])
-				: (pop_amount - (*cache).population_record[(state.ui_date.value - 30) % 32]);
+		if(snapshot.has_records) {
+			auto const* cache = &snapshot.records;
+			auto pop_amount = (*cache).population_record[snapshot.date.value % 32];
+			auto pop_change = snapshot.date.value <= 32
+				? (snapshot.date.value <= 2 ? 0.0f : pop_amount - (*cache).population_record[2])
+				: (pop_amount - (*cache).population_record[(snapshot.date.value - 30) % 32]);
 
 			text::text_color color = pop_change < 0 ? text::text_color::red : text::text_color::green;
 			if(pop_change == 0)
@@ -285,14 +282,16 @@ public:
 
 		auto nation_id = retrieve<dcon::nation_id>(state, parent);
 
-		if(auto* cache = state.find_player_data_cache(state.local_player_nation)) {
-			auto pop_amount = (*cache).population_record[state.ui_date.value % 32];
-			auto pop_change = state.ui_date.value <= 30 ? 0.0f : (pop_amount - (*cache).population_record[(state.ui_date.value - 30) % 32]);
+		auto const& snapshot = state.current_ui_snapshot;
+		if(snapshot.has_records) {
+			auto const* cache = &snapshot.records;
+			auto pop_amount = (*cache).population_record[snapshot.date.value % 32];
+			auto pop_change = snapshot.date.value <= 30 ? 0.0f : (pop_amount - (*cache).population_record[(snapshot.date.value - 30) % 32]);
 
-			text::add_line(state, contents, "pop_growth_topbar_3", text::variable_type::curr, text::pretty_integer{ int64_t(state.world.nation_get_demographics(nation_id, demographics::total)) });
+			text::add_line(state, contents, "pop_growth_topbar_3", text::variable_type::curr, text::pretty_integer{ int64_t(snapshot.population) });
 			text::add_line(state, contents, "pop_growth_topbar_2", text::variable_type::x, text::pretty_integer{ int64_t(pop_change) });
-			text::add_line(state, contents, "pop_growth_topbar", text::variable_type::x, text::pretty_integer{ int64_t(nations::get_monthly_pop_increase_of_nation(state, nation_id)) });
-			text::add_line(state, contents, "pop_growth_topbar_4", text::variable_type::val, text::pretty_integer{ int64_t(state.world.nation_get_demographics(nation_id, demographics::total) * 4) });
+			text::add_line(state, contents, "pop_growth_topbar", text::variable_type::x, text::pretty_integer{ snapshot.monthly_pop_increase });
+			text::add_line(state, contents, "pop_growth_topbar_4", text::variable_type::val, text::pretty_integer{ int64_t(snapshot.population * 4) });
 
 			text::add_line_break_to_layout(state, contents);
 		}
@@ -305,18 +304,18 @@ public:
 class topbar_treasury_text : public multiline_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		auto n = retrieve<dcon::nation_id>(state, parent);
+		auto const& snapshot = state.current_ui_snapshot;
 
 		auto layout = text::create_endless_layout(state, internal_layout,
 		text::layout_parameters{ 0, 0, int16_t(base_data.size.x), int16_t(base_data.size.y), base_data.data.text.font_handle, 0, text::alignment::center, text::text_color::black, false });
 		auto box = text::open_layout_box(layout, 0);
 
-		if(auto* cache = state.find_player_data_cache(state.local_player_nation)) {
-			auto current_day_record = (*cache).treasury_record[state.ui_date.value % 32];
-			auto previous_day_record = (*cache).treasury_record[(state.ui_date.value + 31) % 32];
+		if(snapshot.has_records) {
+			auto current_day_record = snapshot.records.treasury_record[snapshot.date.value % 32];
+			auto previous_day_record = snapshot.records.treasury_record[(snapshot.date.value + 31) % 32];
 			auto change = current_day_record - previous_day_record;
 
-			text::add_to_layout_box(state, layout, box, text::prettify_currency(nations::get_treasury(state, n)));
+			text::add_to_layout_box(state, layout, box, text::prettify_currency(snapshot.treasury));
 			text::add_to_layout_box(state, layout, box, std::string(" ("));
 			if(change > 0) {
 				text::add_to_layout_box(state, layout, box, std::string("+"), text::text_color::green);
@@ -414,7 +413,7 @@ public:
 
 		{
 			text::substitution_map sub{};
-			text::add_to_substitution_map(sub, text::variable_type::x, text::fp_currency{ state.world.nation_get_private_investment(state.local_player_nation) });
+			text::add_to_substitution_map(sub, text::variable_type::x, text::fp_currency{ state.current_ui_snapshot.private_investment });
 			auto box = text::open_layout_box(contents, 0);
 			text::localised_format_box(state, contents, box, "investment_pool", sub);
 			text::close_layout_box(contents, box);
@@ -603,10 +602,7 @@ public:
 	}
 
 	void on_update(sys::state& state) noexcept override {
-		auto nation_id = retrieve<dcon::nation_id>(state, parent);
-		auto militancy = state.world.nation_get_demographics(nation_id, demographics::militancy);
-		auto total_pop = state.world.nation_get_demographics(nation_id, demographics::total);
-		set_text(state, text::format_float(total_pop == 0.f ? 0.f : militancy / total_pop));
+		set_text(state, text::format_float(state.current_ui_snapshot.militancy));
 	}
 
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
@@ -617,12 +613,8 @@ public:
 		auto nation_id = retrieve<dcon::nation_id>(state, parent);
 		auto box = text::open_layout_box(contents, 0);
 		text::substitution_map sub;
-		auto mil_change = demographics::get_estimated_mil_change(state, nation_id);
-		auto total = state.world.nation_get_demographics(nation_id, demographics::total);
-		text::add_to_substitution_map(sub, text::variable_type::avg,
-				text::fp_two_places{total != 0.f ? state.world.nation_get_demographics(nation_id, demographics::militancy) / total : 0.f});
-		text::add_to_substitution_map(sub, text::variable_type::val,
-				text::fp_four_places{mil_change});
+		text::add_to_substitution_map(sub, text::variable_type::avg, text::fp_two_places{ state.current_ui_snapshot.militancy });
+		text::add_to_substitution_map(sub, text::variable_type::val, text::fp_four_places{ state.current_ui_snapshot.militancy_change });
 		text::localised_format_box(state, contents, box, std::string_view("topbar_avg_mil"), sub);
 		text::add_line_break_to_layout_box(state, contents, box);
 		text::localised_format_box(state, contents, box, std::string_view("topbar_avg_change"), sub);
@@ -647,10 +639,7 @@ public:
 	}
 
 	void on_update(sys::state& state) noexcept override {
-		auto nation_id = retrieve<dcon::nation_id>(state, parent);
-		auto militancy = state.world.nation_get_demographics(nation_id, demographics::consciousness);
-		auto total_pop = state.world.nation_get_demographics(nation_id, demographics::total);
-		set_text(state, text::format_float(total_pop == 0.f ? 0.f : militancy / total_pop));
+		set_text(state, text::format_float(state.current_ui_snapshot.consciousness));
 	}
 
 	void update_tooltip(sys::state& state, int32_t x, int32_t y, text::columnar_layout& contents) noexcept override {
@@ -658,11 +647,8 @@ public:
 
 		auto box = text::open_layout_box(contents, 0);
 		text::substitution_map sub;
-		auto con_change = demographics::get_estimated_con_change(state, nation_id);
-		auto total = state.world.nation_get_demographics(nation_id, demographics::total);
-		text::add_to_substitution_map(sub, text::variable_type::avg,
-				text::fp_two_places{ total != 0.f ? (state.world.nation_get_demographics(nation_id, demographics::consciousness) / total) : 0.f });
-		text::add_to_substitution_map(sub, text::variable_type::val, text::fp_four_places{ con_change });
+		text::add_to_substitution_map(sub, text::variable_type::avg, text::fp_two_places{ state.current_ui_snapshot.consciousness });
+		text::add_to_substitution_map(sub, text::variable_type::val, text::fp_four_places{ state.current_ui_snapshot.consciousness_change });
 		text::localised_format_box(state, contents, box, std::string_view("topbar_avg_con"), sub);
 		text::add_line_break_to_layout_box(state, contents, box);
 		text::localised_format_box(state, contents, box, std::string_view("topbar_avg_change"), sub);
@@ -683,8 +669,7 @@ public:
 	}
 
 	void on_update(sys::state& state) noexcept override {
-		auto points = nations::diplomatic_points(state, retrieve<dcon::nation_id>(state, parent));
-		set_text(state, text::format_float(points, 1));
+		set_text(state, text::format_float(state.current_ui_snapshot.diplomatic_points, 1));
 	}
 
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
@@ -697,11 +682,11 @@ public:
 		auto box = text::open_layout_box(contents, 0);
 		text::substitution_map sub;
 		text::add_to_substitution_map(sub, text::variable_type::curr,
-			text::fp_one_place{ nations::diplomatic_points(state, nation_id) });
+			text::fp_one_place{ state.current_ui_snapshot.diplomatic_points });
 
 		// Monthly gain
 		text::add_to_substitution_map(sub, text::variable_type::value,
-			text::fp_one_place{ nations::monthly_diplomatic_points(state, nation_id) });
+			text::fp_one_place{ state.current_ui_snapshot.monthly_diplomatic_points });
 
 		text::substitution_map sub_base;
 		// Base gain
@@ -920,6 +905,10 @@ public:
 	sound::audio_instance& get_click_sound(sys::state& state) noexcept override {
 		return sound::get_tab_diplomacy_sound(state);
 	}
+	void on_hover(sys::state& state) noexcept override {
+		// the diplomacy window shows every flag at once, so start decoding them before it opens
+		ogl::prefetch_flag_handles(state);
+	}
 };
 class topbar_military_tab_button : public topbar_tab_button {
 public:
@@ -985,7 +974,7 @@ public:
 class topbar_date_text : public simple_text_element_base {
 public:
 	void on_update(sys::state& state) noexcept override {
-		set_text(state, text::date_to_string(state, state.current_date));
+		set_text(state, text::date_to_string(state, state.current_ui_snapshot.date));
 	}
 	tooltip_behavior has_tooltip(sys::state& state) noexcept override {
 		return tooltip_behavior::variable_tooltip;
@@ -1926,6 +1926,7 @@ struct pop_details_main_iss_list_t : public layout_generator {
 };
 struct pop_details_main_emm_list_t : public layout_generator {
 // BEGIN main::emm_list::variables
+	::table::incremental_order<dcon::nation_id, std::array<float, 2>> emm_order;
 // END
 	struct emm_row_option { dcon::nation_id destination; };
 	std::vector<std::unique_ptr<ui::element_base>> emm_row_pool;
@@ -1942,6 +1943,7 @@ struct pop_details_main_emm_list_t : public layout_generator {
 };
 struct pop_details_main_mig_list_t : public layout_generator {
 // BEGIN main::mig_list::variables
+	::table::incremental_order<dcon::province_id, std::array<float, 2>> mig_order;
 // END
 	struct mig_row_option { dcon::province_id destination; };
 	std::vector<std::unique_ptr<ui::element_base>> mig_row_pool;
@@ -3735,6 +3737,39 @@ void  pop_details_main_emm_list_t::update(sys::state& state, layout_window_eleme
 			//float weight = std::max(0.0f, interp_result * std::max(0.f, (state.world.nation_get_modifier_values(n, sys::national_mod_offsets::global_immigrant_attract) + 1.0f)));
 		}
 	}
+
+	// weights and names are computed once per row instead of per comparison, and only rows whose key changed are sorted again
+	if(main.emm_table_destination_sort_direction == 0 && main.emm_table_weight_sort_direction == 0) {
+		emm_order.invalidate();
+		return;
+	}
+	std::vector<dcon::nation_id> rows;
+	std::vector<std::string> names;
+	for(auto const& v : values) {
+		rows.push_back(std::get<emm_row_option>(v).destination);
+	}
+	std::vector<std::array<float, 2>> keys(rows.size());
+	if(main.emm_table_weight_sort_direction != 0) {
+		for(size_t i = 0; i < rows.size(); ++i) {
+			float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(rows[i]), trigger::to_generic(main.for_pop), 0);
+			float weight = std::max(0.0f, interp_result * std::max(0.f, (state.world.nation_get_modifier_values(rows[i], sys::national_mod_offsets::global_immigrant_attract) + 1.0f)));
+			keys[i][0] = float(main.emm_table_weight_sort_direction) * weight;
+		}
+	}
+	if(main.emm_table_destination_sort_direction != 0) {
+		for(auto n : rows) {
+			names.push_back(text::produce_simple_string(state, text::get_name(state, n)));
+		}
+		auto ranks = ::table::rank_names(names);
+		for(size_t i = 0; i < rows.size(); ++i) {
+			keys[i][1] = float(main.emm_table_destination_sort_direction) * ranks[i];
+		}
+	}
+	auto const& order = emm_order.update(rows, std::move(keys));
+	for(size_t i = 0; i < rows.size(); ++i) {
+		values[i] = emm_row_option{ rows[order[i]] };
+	}
+	return;
 // END
 	{
 	bool work_to_do = false;
@@ -3872,6 +3907,37 @@ void  pop_details_main_mig_list_t::update(sys::state& state, layout_window_eleme
 			}
 		}
 	}
+
+	// weights and names are computed once per row instead of per comparison, and only rows whose key changed are sorted again
+	if(main.mig_table_destination_sort_direction == 0 && main.mig_table_weight_sort_direction == 0) {
+		mig_order.invalidate();
+		return;
+	}
+	std::vector<dcon::province_id> rows;
+	std::vector<std::string> names;
+	for(auto const& v : values) {
+		rows.push_back(std::get<mig_row_option>(v).destination);
+	}
+	std::vector<std::array<float, 2>> keys(rows.size());
+	if(main.mig_table_weight_sort_direction != 0) {
+		for(size_t i = 0; i < rows.size(); ++i) {
+			keys[i][0] = float(main.mig_table_weight_sort_direction) * demographics::explain_province_internal_migration_weight(state, main.for_pop, rows[i]).result;
+		}
+	}
+	if(main.mig_table_destination_sort_direction != 0) {
+		for(auto p : rows) {
+			names.push_back(text::produce_simple_string(state, state.world.province_get_name(p)));
+		}
+		auto ranks = ::table::rank_names(names);
+		for(size_t i = 0; i < rows.size(); ++i) {
+			keys[i][1] = float(main.mig_table_destination_sort_direction) * ranks[i];
+		}
+	}
+	auto const& order = mig_order.update(rows, std::move(keys));
+	for(size_t i = 0; i < rows.size(); ++i) {
+		values[i] = mig_row_option{ rows[order[i]] };
+	}
+	return;
 // END
 	{
 	bool work_to_do = false;
@@ -38,6 +38,88 @@ struct sort_data {
 	uint8_t sorted_index;
 };
 
+// keeps the order of a list of rows sorted by a precomputed key between updates; when the rows are the same as in the
+// previous update only those whose key changed are sorted again and merged back into the others, which still are in order
+// either way the result is that of a stable sort by key, ties keep the order in which the rows were given
+template<typename row_type, typename key_type>
+class incremental_order {
+	std::vector<row_type> rows;
+	std::vector<key_type> keys;
+	std::vector<uint32_t> order;
+public:
+	uint32_t last_sorted_count = 0; // how many rows the last update had to sort
+
+	void invalidate() {
+		rows.clear();
+		keys.clear();
+		order.clear();
+	}
+
+	// new_keys[i] is the key of new_rows[i], returns indices into new_rows in sorted order
+	std::vector<uint32_t> const& update(std::vector<row_type> const& new_rows, std::vector<key_type>&& new_keys) {
+		auto less = [&](uint32_t a, uint32_t b) {
+			if(new_keys[a] < new_keys[b])
+				return true;
+			if(new_keys[b] < new_keys[a])
+				return false;
+			return a < b;
+		};
+
+		std::vector<uint32_t> changed;
+		bool full_sort = new_rows != rows;
+		if(!full_sort) {
+			for(uint32_t i = 0; i < uint32_t(new_keys.size()); ++i) {
+				if(!(new_keys[i] == keys[i]))
+					changed.push_back(i);
+			}
+			full_sort = changed.size() * 4 > new_keys.size();
+		}
+
+		if(full_sort) {
+			order.resize(new_rows.size());
+			for(uint32_t i = 0; i < uint32_t(order.size()); ++i)
+				order[i] = i;
+			sys::merge_sort(order.begin(), order.end(), less);
+			last_sorted_count = uint32_t(order.size());
+		} else {
+			last_sorted_count = uint32_t(changed.size());
+			if(!changed.empty()) {
+				std::vector<bool> is_changed(new_keys.size(), false);
+				for(auto i : changed)
+					is_changed[i] = true;
+				std::vector<uint32_t> unchanged;
+				unchanged.reserve(order.size() - changed.size());
+				for(auto i : order) {
+					if(!is_changed[i])
+						unchanged.push_back(i);
+				}
+				sys::merge_sort(changed.begin(), changed.end(), less);
+				std::merge(unchanged.begin(), unchanged.end(), changed.begin(), changed.end(), order.begin(), less);
+			}
+		}
+
+		rows = new_rows;
+		keys = std::move(new_keys);
+		return order;
+	}
+};
+
+// the rank of each name among the others, equal names share a rank, so comparing ranks is the same as comparing the names
+inline std::vector<float> rank_names(std::vector<std::string> const& names) {
+	std::vector<uint32_t> by_name(names.size());
+	for(uint32_t i = 0; i < uint32_t(by_name.size()); ++i)
+		by_name[i] = i;
+	sys::merge_sort(by_name.begin(), by_name.end(), [&](uint32_t a, uint32_t b) { return names[a] < names[b]; });
+	std::vector<float> ranks(names.size(), 0.0f);
+	float rank = 0.0f;
+	for(size_t i = 0; i < by_name.size(); ++i) {
+		if(i > 0 && names[by_name[i]] != names[by_name[i - 1]])
+			rank += 1.0f;
+		ranks[by_name[i]] = rank;
+	}
+	return ranks;
+}
+
 template<typename item_type>
 void tooltip_fallback (sys::state& state, ui::element_base* container, text::columnar_layout& contents, const item_type& a, std::string fallback) {
 	auto box = text::open_layout_box(contents, 0);
@@ -69,6 +151,21 @@ struct data {
 	std::vector<sort_data> sort_priority;
 	std::vector<item_type> data;
 
+	// stable sorting once per priority is the same as one lexicographic sort with the last priority first
+	bool compare_rows(sys::state& state, ui::element_base* container, const item_type& a, const item_type& b) {
+		for(auto i = sort_priority.size(); i-- > 0; ) {
+			auto& compare = columns[sort_priority[i].sorted_index].compare;
+			auto const& first = sort_priority[i].order == sort_order::ascending ? a : b;
+			auto const& second = sort_priority[i].order == sort_order::ascending ? b : a;
+			if(compare(state, container, first, second))
+				return true;
+			// the last key decides nothing further, so there is no need to test the reverse
+			if(i == 0 || compare(state, container, second, first))
+				return false;
+		}
+		return false;
+	}
+
 	void toggle_sort_column_by_index(uint8_t column_index) {
 		if(!columns[column_index].sortable) {
 			return;
@@ -97,25 +194,15 @@ struct data {
 	}
 
 	void update_rows_order(sys::state& state, ui::element_base* container) {
-		for(auto& order : sort_priority) {
-			if(order.order == sort_order::ascending) {
-				sys::merge_sort(
-					data.begin(),
-					data.end(),
-					[&](const item_type& a, const item_type& b) {
-						return columns[order.sorted_index].compare(state, container, a, b);
-					}
-				);
-			} else {
-				sys::merge_sort(
-					data.begin(),
-					data.end(),
-					[&](const item_type& a, const item_type& b) {
-						return columns[order.sorted_index].compare(state, container, b, a);
-					}
-				);
+		if(sort_priority.empty())
+			return;
+		sys::merge_sort(
+			data.begin(),
+			data.end(),
+			[&](const item_type& a, const item_type& b) {
+				return compare_rows(state, container, a, b);
 			}
-		}
+		);
 	}
 };
 
@@ -653,6 +740,7 @@ public:
 		if(std::floor(impulse) != std::floor(table_body->scroll_impulse)) {
 			table_body->list_scrollbar->update_raw_value(state, table_body->list_scrollbar->raw_value() + (impulse < 0 ? 1 : -1));
 			state.ui_state.last_tooltip = nullptr; //force update of tooltip
+			state.ui_state.tooltip->cache.clear();
 			table_body->update(state);
 		}
 
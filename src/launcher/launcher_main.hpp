@@ -117,6 +117,8 @@ static std::string requestedScenarioFileName;
 static std::string enabledModsMask;
 static bool autoBuild = false;
 static bool headless = false;
+// servers running several instances trade disk space for faster loads with shared, already decompressed pages
+static bool uncompressedScenario = false;
 
 enum class string_index : uint8_t {
 	create_scenario,
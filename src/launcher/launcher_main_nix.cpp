@@ -37,11 +37,27 @@ void make_mod_file() {
 			fprintf(stderr, "File common/bookmarks.txt could not be opened\n");
 		}
 
+		// nothing the scenario was built from has changed since an earlier build, so that file is reused as is; the later bookmarks
+		// are still written again for it, since they are ordinary saves that may have been deleted or replaced since
+		auto content_key = sys::compute_content_checksum(fs_root);
 		sys::checksum_key scenario_key;
+		uint32_t first_date_index = 0;
+		if(requestedScenarioFileName == "") {
+			// debug builds also write each later bookmark as a scenario with a count of 0, those must never be picked
+			auto existing = std::find_if(scenario_files.begin(), scenario_files.end(), [&](scenario_file const& f) {
+				return f.ident.count != 0 && f.ident.mod_path == path && f.ident.content_checksum.is_equal(content_key);
+			});
+			if(existing != scenario_files.end()) {
+				selected_scenario_file = existing->file_name;
+				fprintf(stdout, std::string("Scenario " + selected_scenario_file + " is up to date and selected\n").c_str());
+				scenario_key = existing->ident.scenario_checksum;
+				first_date_index = 1;
+			}
+		}
 
 		fprintf(stdout, (std::string("Loaded ") + std::to_string(uint32_t(bookmark_context.bookmark_dates.size())) + " bookmarks\n").c_str());
 
-		for(uint32_t date_index = 0; date_index < uint32_t(bookmark_context.bookmark_dates.size()); date_index++) {
+		for(uint32_t date_index = first_date_index; date_index < uint32_t(bookmark_context.bookmark_dates.size()); date_index++) {
 			err.accumulated_errors.clear();
 			err.accumulated_warnings.clear();
 			//
@@ -67,7 +83,7 @@ void make_mod_file() {
 				}
 				++max_scenario_count;
 				selected_scenario_file = generated_scenario_name;
-				sys::write_scenario_file(*game_state, selected_scenario_file, max_scenario_count);
+				sys::write_scenario_file(*game_state, selected_scenario_file, max_scenario_count, content_key, !uncompressedScenario);
 
 				fprintf(stdout, std::string("Scenario " + selected_scenario_file + " built and selected\n").c_str());
 
@@ -84,7 +100,7 @@ void make_mod_file() {
 				scenario_key = game_state->scenario_checksum;
 			} else {
 	#ifndef NDEBUG
-				sys::write_scenario_file(*game_state, std::to_string(date_index) + NATIVE(".bin"), 0);
+				sys::write_scenario_file(*game_state, std::to_string(date_index) + NATIVE(".bin"), 0, content_key);
 	#endif
 				game_state->scenario_checksum = scenario_key;
 				sys::write_save_file(*game_state, sys::save_type::bookmark, bookmark_context.bookmark_dates[date_index].name_);
@@ -1159,6 +1175,8 @@ int main(int argc, char* argv[]) {
 			enabledModsMask = argv[i + 1];
 		} else if(arg == "-autoBuild") {
 			autoBuild = true;
+		} else if(arg == "-uncompressedScenario") {
+			uncompressedScenario = true;
 		}
 	}
 
@@ -103,9 +103,24 @@ void make_mod_file() {
 			err.accumulated_errors += "File common/bookmarks.txt could not be opened\n";
 		}
 
+		// nothing the scenario was built from has changed since an earlier build, so that file is reused as is; the later bookmarks
+		// are still written again for it, since they are ordinary saves that may have been deleted or replaced since
+		auto content_key = sys::compute_content_checksum(fs_root);
 		sys::checksum_key scenario_key;
+		uint32_t first_date_index = 0;
+		if(requestedScenarioFileName == "") {
+			// debug builds also write each later bookmark as a scenario with a count of 0, those must never be picked
+			auto existing = std::find_if(scenario_files.begin(), scenario_files.end(), [&](scenario_file const& f) {
+				return f.ident.count != 0 && f.ident.mod_path == path && f.ident.content_checksum.is_equal(content_key);
+			});
+			if(existing != scenario_files.end()) {
+				selected_scenario_file = existing->file_name;
+				scenario_key = existing->ident.scenario_checksum;
+				first_date_index = 1;
+			}
+		}
 
-		for(uint32_t date_index = 0; date_index < uint32_t(bookmark_context.bookmark_dates.size()); date_index++) {
+		for(uint32_t date_index = first_date_index; date_index < uint32_t(bookmark_context.bookmark_dates.size()); date_index++) {
 			err.accumulated_errors.clear();
 			err.accumulated_warnings.clear();
 			//
@@ -129,7 +144,7 @@ void make_mod_file() {
 				}
 				++max_scenario_count;
 				selected_scenario_file = generated_scenario_name;
-				sys::write_scenario_file(*game_state, selected_scenario_file, max_scenario_count);
+				sys::write_scenario_file(*game_state, selected_scenario_file, max_scenario_count, content_key, !uncompressedScenario);
 				if(auto of = simple_fs::open_file(sdir, selected_scenario_file); of) {
 					auto content = view_contents(*of);
 					auto desc = sys::extract_mod_information(reinterpret_cast<uint8_t const*>(content.data), content.file_size);
@@ -143,7 +158,7 @@ void make_mod_file() {
 				scenario_key = game_state->scenario_checksum;
 			} else {
 #ifndef NDEBUG
-				sys::write_scenario_file(*game_state, std::to_wstring(date_index) + NATIVE(".bin"), 0);
+				sys::write_scenario_file(*game_state, std::to_wstring(date_index) + NATIVE(".bin"), 0, content_key);
 #endif
 				game_state->scenario_checksum = scenario_key;
 				sys::write_save_file(*game_state, sys::save_type::bookmark, bookmark_context.bookmark_dates[date_index].name_);
@@ -1159,6 +1174,9 @@ LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
 			if(native_string(parsed_cmd[i]) == NATIVE("-autoBuild")) {
 				autoBuild = true;
 			}
+			if(native_string(parsed_cmd[i]) == NATIVE("-uncompressedScenario")) {
+				uncompressedScenario = true;
+			}
 		}
 
 		find_scenario_file();
@@ -36,141 +36,118 @@
 //
 // EXTRA MAP MODES
 //
-std::vector<uint32_t> ideology_map_from(sys::state& state) {
+// colors the provinces passing the owner filter from a value computed with ve over blocks of provinces, in parallel
+template<typename V, typename C>
+static void fill_province_colors(sys::state& state, std::vector<uint32_t>& prov_color, uint32_t texture_size, dcon::nation_id sel_nation, V&& value_of, C&& color_of) {
+	state.world.execute_parallel_over_province([&](auto ids) {
+		auto values = value_of(ids);
+		auto owners = state.world.province_get_nation_from_province_ownership(ids);
+		ve::apply([&](dcon::province_id p, dcon::nation_id owner, float value) {
+			if(sel_nation && owner != sel_nation)
+				return;
+			auto color = color_of(value);
+			auto i = province::to_map_id(p);
+			prov_color[i] = color;
+			prov_color[i + texture_size] = color;
+		}, ids, owners, values);
+	});
+}
+
+// colors every province by the share of its pops holding the dominant ideology or issue of the selected province
+template<typename K>
+static void fill_pop_share_colors(sys::state& state, std::vector<uint32_t>& prov_color, uint32_t texture_size, K pkey, uint32_t full_color) {
+	uint32_t empty_color = 0xDDDDDD;
+	// Make the other end of the gradient dark if the color is bright and vice versa.
+	if((full_color & 0xFF) + (full_color >> 8 & 0xFF) + (full_color >> 16 & 0xFF) > 140 * 3) {
+		empty_color = 0x222222;
+	}
+	concurrency::parallel_for(uint32_t(0), state.world.province_size(), [&](uint32_t id) {
+		dcon::province_id prov_id{ dcon::province_id::value_base_t(id) };
+		auto i = province::to_map_id(prov_id);
+		float total = 0.f;
+		float value = 0.f;
+		for(const auto pl : state.world.province_get_pop_location_as_province(prov_id)) {
+			value += pop_demographics::get_demo(state, pl.get_pop(), pkey) * pl.get_pop().get_size();
+			total += pl.get_pop().get_size();
+		}
+		auto ratio = value / total;
+		auto color = ogl::color_gradient(ratio, full_color, empty_color);
+		prov_color[i] = color;
+		prov_color[i + texture_size] = color;
+	});
+}
+
+// colors every province by its dominant ideology or issue option, striped with the runner-up when it is close
+template<typename T, typename F>
+static void fill_dominant_colors(sys::state& state, std::vector<uint32_t>& prov_color, uint32_t texture_size, F&& for_each_option) {
+	concurrency::parallel_for(uint32_t(0), state.world.province_size(), [&](uint32_t pid) {
+		dcon::province_id prov_id{ dcon::province_id::value_base_t(pid) };
+		auto id = province::to_map_id(prov_id);
+		float total_pops = state.world.province_get_demographics(prov_id, demographics::total);
+		T primary_id;
+		T secondary_id;
+		float primary_percent = 0.f;
+		float secondary_percent = 0.f;
+		for_each_option([&](T id) {
+			auto demo_key = demographics::to_key(state, id);
+			auto volume = state.world.province_get_demographics(prov_id, demo_key);
+			float percent = volume / total_pops;
+			if(percent > primary_percent) {
+				secondary_id = primary_id;
+				secondary_percent = primary_percent;
+				primary_id = id;
+				primary_percent = percent;
+			} else if(percent > secondary_percent) {
+				secondary_id = id;
+				secondary_percent = percent;
+			}
+		});
+		uint32_t primary_color = ogl::get_ui_color(state, primary_id);
+		uint32_t secondary_color = 0xFFAAAAAA; // This color won't be reached
+		if(bool(secondary_id)) {
+			secondary_color = ogl::get_ui_color(state, secondary_id);
+		}
+		if(secondary_percent >= primary_percent * 0.75f) {
+			prov_color[id] = primary_color;
+			prov_color[id + texture_size] = secondary_color;
+		} else {
+			prov_color[id] = primary_color;
+			prov_color[id + texture_size] = primary_color;
+		}
+	});
+}
+
+std::vector<uint32_t> ideology_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size() + 1;
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	if(state.map_state.get_selected_province()) {
-		auto fat_id = state.world.province_get_dominant_ideology(state.map_state.get_selected_province());
+	if(in.selection) {
+		auto fat_id = state.world.province_get_dominant_ideology(in.selection);
 		if(bool(fat_id)) {
-			uint32_t full_color = fat_id.get_color();
-			uint32_t empty_color = 0xDDDDDD;
-			// Make the other end of the gradient dark if the color is bright and vice versa.
-			if((full_color & 0xFF) + (full_color >> 8 & 0xFF) + (full_color >> 16 & 0xFF) > 140 * 3) {
-				empty_color = 0x222222;
-			}
-			auto const pkey = pop_demographics::to_key(state, fat_id.id);
-			state.world.for_each_province([&](dcon::province_id prov_id) {
-				auto i = province::to_map_id(prov_id);
-				float total = 0.f;
-				float value = 0.f;
-				for(const auto pl : state.world.province_get_pop_location_as_province(prov_id)) {
-					value += pop_demographics::get_demo(state, pl.get_pop(), pkey) * pl.get_pop().get_size();
-					total += pl.get_pop().get_size();
-				}
-				auto ratio = value / total;
-				auto color = ogl::color_gradient(ratio, full_color, empty_color);
-				prov_color[i] = color;
-				prov_color[i + texture_size] = color;
-			});
+			fill_pop_share_colors(state, prov_color, texture_size, pop_demographics::to_key(state, fat_id.id), fat_id.get_color());
 		}
 	} else {
-		state.world.for_each_province([&](dcon::province_id prov_id) {
-			auto id = province::to_map_id(prov_id);
-			float total_pops = state.world.province_get_demographics(prov_id, demographics::total);
-			dcon::ideology_id primary_id;
-			dcon::ideology_id secondary_id;
-			float primary_percent = 0.f;
-			float secondary_percent = 0.f;
-			state.world.for_each_ideology([&](dcon::ideology_id id) {
-				auto demo_key = demographics::to_key(state, id);
-				auto volume = state.world.province_get_demographics(prov_id, demo_key);
-				float percent = volume / total_pops;
-				if(percent > primary_percent) {
-					secondary_id = primary_id;
-					secondary_percent = primary_percent;
-					primary_id = id;
-					primary_percent = percent;
-				} else if(percent > secondary_percent) {
-					secondary_id = id;
-					secondary_percent = percent;
-				}
-			});
-			uint32_t primary_color = dcon::fatten(state.world, primary_id).get_color();
-			uint32_t secondary_color = 0xFFAAAAAA; // This color won't be reached
-			if(bool(secondary_id)) {
-				secondary_color = dcon::fatten(state.world, secondary_id).get_color();
-			}
-			if(secondary_percent >= primary_percent * 0.75f) {
-				prov_color[id] = primary_color;
-				prov_color[id + texture_size] = secondary_color;
-			} else {
-				prov_color[id] = primary_color;
-				prov_color[id + texture_size] = primary_color;
-			}
-		});
+		fill_dominant_colors<dcon::ideology_id>(state, prov_color, texture_size, [&](auto&& f) { state.world.for_each_ideology(f); });
 	}
 	return prov_color;
 }
 
-std::vector<uint32_t> issue_map_from(sys::state& state) {
+std::vector<uint32_t> issue_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size() + 1;
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	if(state.map_state.get_selected_province()) {
-		auto fat_id = state.world.province_get_dominant_issue_option(state.map_state.get_selected_province());
+	if(in.selection) {
+		auto fat_id = state.world.province_get_dominant_issue_option(in.selection);
 		if(bool(fat_id)) {
-			uint32_t full_color = ogl::get_ui_color(state, fat_id.id);
-			uint32_t empty_color = 0xDDDDDD;
-			// Make the other end of the gradient dark if the color is bright and vice versa.
-			if((full_color & 0xFF) + (full_color >> 8 & 0xFF) + (full_color >> 16 & 0xFF) > 140 * 3) {
-				empty_color = 0x222222;
-			}
-			auto const pkey = pop_demographics::to_key(state, fat_id.id);
-			state.world.for_each_province([&](dcon::province_id prov_id) {
-				auto i = province::to_map_id(prov_id);
-				float total = 0.f;
-				float value = 0.f;
-				for(const auto pl : state.world.province_get_pop_location_as_province(prov_id)) {
-					value += pop_demographics::get_demo(state, pl.get_pop(), pkey) * pl.get_pop().get_size();
-					total += pl.get_pop().get_size();
-				}
-				auto ratio = value / total;
-				auto color = ogl::color_gradient(ratio, full_color, empty_color);
-				prov_color[i] = color;
-				prov_color[i + texture_size] = color;
-			});
+			fill_pop_share_colors(state, prov_color, texture_size, pop_demographics::to_key(state, fat_id.id), ogl::get_ui_color(state, fat_id.id));
 		}
 	} else {
-		state.world.for_each_province([&](dcon::province_id prov_id) {
-			auto id = province::to_map_id(prov_id);
-			float total_pops = state.world.province_get_demographics(prov_id, demographics::total);
-			dcon::issue_option_id primary_id;
-			dcon::issue_option_id secondary_id;
-			float primary_percent = 0.f;
-			float secondary_percent = 0.f;
-			state.world.for_each_issue_option([&](dcon::issue_option_id id) {
-				auto demo_key = demographics::to_key(state, id);
-				auto volume = state.world.province_get_demographics(prov_id, demo_key);
-				float percent = volume / total_pops;
-				if(percent > primary_percent) {
-					secondary_id = primary_id;
-					secondary_percent = primary_percent;
-					primary_id = id;
-					primary_percent = percent;
-				} else if(percent > secondary_percent) {
-					secondary_id = id;
-					secondary_percent = percent;
-				}
-			});
-			uint32_t primary_color = ogl::get_ui_color(state, primary_id);
-			uint32_t secondary_color = 0xFFAAAAAA; // This color won't be reached
-			if(bool(secondary_id)) {
-				secondary_color = ogl::get_ui_color(state, secondary_id);
-			}
-			if(secondary_percent >= primary_percent * 0.75f) {
-				prov_color[id] = primary_color;
-				prov_color[id + texture_size] = secondary_color;
-			} else {
-				prov_color[id] = primary_color;
-				prov_color[id + texture_size] = primary_color;
-			}
-		});
+		fill_dominant_colors<dcon::issue_option_id>(state, prov_color, texture_size, [&](auto&& f) { state.world.for_each_issue_option(f); });
 	}
 	return prov_color;
 }
 
-std::vector<uint32_t> fort_map_from(sys::state& state) {
+std::vector<uint32_t> fort_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
@@ -178,7 +155,7 @@ std::vector<uint32_t> fort_map_from(sys::state& state) {
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		int32_t current_lvl = state.world.province_get_building_level(prov_id, uint8_t(economy::province_building_type::fort));
-		int32_t max_local_lvl = state.world.nation_get_max_building_level(state.local_player_nation, uint8_t(economy::province_building_type::fort));
+		int32_t max_local_lvl = state.world.nation_get_max_building_level(in.player, uint8_t(economy::province_building_type::fort));
 		uint32_t color = 0x222222;
 		uint32_t stripe_color = 0x222222;
 
@@ -189,9 +166,9 @@ std::vector<uint32_t> fort_map_from(sys::state& state) {
 				sys::pack_color(41, 5, 245) // blue
 			);
 		}
-		if(province::can_build_fort(state, prov_id, state.local_player_nation)) {
+		if(province::can_build_fort(state, prov_id, in.player)) {
 			stripe_color = sys::pack_color(232, 228, 111); // yellow
-		} else if(nation == state.local_player_nation && province::has_fort_being_built(state, prov_id)) {
+		} else if(nation == in.player && province::has_fort_being_built(state, prov_id)) {
 			stripe_color = sys::pack_color(247, 15, 15); // yellow
 		} else {
 			stripe_color = color;
@@ -203,12 +180,12 @@ std::vector<uint32_t> fort_map_from(sys::state& state) {
 	return prov_color;
 }
 
-std::vector<uint32_t> factory_map_from(sys::state& state) {
+std::vector<uint32_t> factory_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
 
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
 	// get state with most factories
 	float max_total = 0;
 	state.world.for_each_province([&](dcon::province_id pid) {
@@ -245,47 +222,33 @@ std::vector<uint32_t> factory_map_from(sys::state& state) {
 	return prov_color;
 }
 
-std::vector<uint32_t> con_map_from(sys::state& state) {
+std::vector<uint32_t> con_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
-	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
-		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto scale = 1.f / 10.f;
-			auto value = scale * (state.world.province_get_demographics(prov_id, demographics::consciousness) / state.world.province_get_demographics(prov_id, demographics::total));
-			uint32_t color = ogl::color_gradient_magma(value);
-			auto i = province::to_map_id(prov_id);
-			prov_color[i] = color;
-			prov_color[i + texture_size] = color;
-		}
-	});
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
+	fill_province_colors(state, prov_color, texture_size, sel_nation, [&](auto ids) {
+		auto scale = 1.f / 10.f;
+		return scale * (state.world.province_get_demographics(ids, demographics::consciousness) / state.world.province_get_demographics(ids, demographics::total));
+	}, [](float value) { return ogl::color_gradient_magma(value); });
 	return prov_color;
 }
 
-std::vector<uint32_t> literacy_map_from(sys::state& state) {
+std::vector<uint32_t> literacy_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
-	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
-		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto value = (state.world.province_get_demographics(prov_id, demographics::literacy) / state.world.province_get_demographics(prov_id, demographics::total));
-			uint32_t color = ogl::color_gradient_viridis(value);
-			auto i = province::to_map_id(prov_id);
-			prov_color[i] = color;
-			prov_color[i + texture_size] = color;
-		}
-	});
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
+	fill_province_colors(state, prov_color, texture_size, sel_nation, [&](auto ids) {
+		return state.world.province_get_demographics(ids, demographics::literacy) / state.world.province_get_demographics(ids, demographics::total);
+	}, [](float value) { return ogl::color_gradient_viridis(value); });
 	return prov_color;
 }
-std::vector<uint32_t> growth_map_from(sys::state& state) {
+std::vector<uint32_t> growth_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	std::vector<float> prov_population_change(state.world.province_size() + 1);
 	std::unordered_map<int32_t, float> continent_max_growth = {};
 	std::unordered_map<int32_t, float> continent_min_growth = {};
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
@@ -327,10 +290,10 @@ std::vector<uint32_t> growth_map_from(sys::state& state) {
 	});
 	return prov_color;
 }
-std::vector<uint32_t> income_map_from(sys::state& state) {
+std::vector<uint32_t> income_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	std::vector<float> prov_population(state.world.province_size() + 1);
 	std::unordered_map<int32_t, float> continent_max_pop = {};
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
@@ -361,36 +324,31 @@ std::vector<uint32_t> income_map_from(sys::state& state) {
 	});
 	return prov_color;
 }
-std::vector<uint32_t> employment_map_from(sys::state& state) {
+std::vector<uint32_t> employment_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
-	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
-		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto value = state.world.province_get_demographics(prov_id, demographics::employed) / state.world.province_get_demographics(prov_id, demographics::employable);
-			uint32_t color = ogl::color_gradient(value,
-				sys::pack_color(46, 247, 15), // green
-				sys::pack_color(247, 15, 15) // red
-			);
-			auto i = province::to_map_id(prov_id);
-			prov_color[i] = color;
-			prov_color[i + texture_size] = color;
-		}
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
+	fill_province_colors(state, prov_color, texture_size, sel_nation, [&](auto ids) {
+		return state.world.province_get_demographics(ids, demographics::employed) / state.world.province_get_demographics(ids, demographics::employable);
+	}, [](float value) {
+		return ogl::color_gradient(value,
+			sys::pack_color(46, 247, 15), // green
+			sys::pack_color(247, 15, 15) // red
+		);
 	});
 	return prov_color;
 }
 
-std::vector<uint32_t> militancy_map_from(sys::state& state) {
+std::vector<uint32_t> militancy_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
-	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto fat_id = dcon::fatten(state.world, prov_id);
-		auto nation = fat_id.get_nation_from_province_ownership();
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
+	concurrency::parallel_for(uint32_t(0), state.world.province_size(), [&](uint32_t id) {
+		dcon::province_id prov_id{ dcon::province_id::value_base_t(id) };
+		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
 			float revolt_risk = province::revolt_risk(state, prov_id) / 10;
 			uint32_t color = ogl::color_gradient_magma(revolt_risk);
@@ -405,104 +363,41 @@ std::vector<uint32_t> militancy_map_from(sys::state& state) {
 //
 // Even newer mapmodes!
 //
-std::vector<uint32_t> life_needs_map_from(sys::state& state) {
-	std::vector<float> prov_satisfaction(state.world.province_size() + 1);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
-	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
-		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto fat_id = dcon::fatten(state.world, prov_id);
-			float population = 0.f;
-			for(const auto pl : state.world.province_get_pop_location_as_province(prov_id))
-				population += pop_demographics::get_life_needs(state, pl.get_pop()) * pl.get_pop().get_size();
-			auto cid = fat_id.get_continent().id.index();
-			auto i = province::to_map_id(prov_id);
-			prov_satisfaction[i] = population / state.world.province_get_demographics(prov_id, demographics::total);
-		}
-	});
+// colors the provinces passing the owner filter by the population weighted need satisfaction of their pops
+template<typename F>
+static std::vector<uint32_t> needs_map_from(sys::state& state, map::map_mode_inputs const& in, F&& needs_of) {
 	uint32_t province_size = state.world.province_size() + 1;
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
-		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto fat_id = dcon::fatten(state.world, prov_id);
-			auto cid = fat_id.get_continent().id.index();
-			auto i = province::to_map_id(prov_id);
-			auto color = ogl::color_gradient_viridis(prov_satisfaction[i]);
-			prov_color[i] = color;
-			prov_color[i + texture_size] = color;
-		}
-	});
-	return prov_color;
-}
-std::vector<uint32_t> everyday_needs_map_from(sys::state& state) {
-	std::vector<float> prov_satisfaction(state.world.province_size() + 1);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
-	state.world.for_each_province([&](dcon::province_id prov_id) {
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
+	concurrency::parallel_for(uint32_t(0), state.world.province_size(), [&](uint32_t id) {
+		dcon::province_id prov_id{ dcon::province_id::value_base_t(id) };
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto fat_id = dcon::fatten(state.world, prov_id);
 			float population = 0.f;
 			for(const auto pl : state.world.province_get_pop_location_as_province(prov_id))
-				population += pop_demographics::get_everyday_needs(state, pl.get_pop()) * pl.get_pop().get_size();
-			auto cid = fat_id.get_continent().id.index();
-			auto i = province::to_map_id(prov_id);
-			prov_satisfaction[i] = population / state.world.province_get_demographics(prov_id, demographics::total);
-		}
-	});
-	uint32_t province_size = state.world.province_size() + 1;
-	uint32_t texture_size = province_size + 256 - province_size % 256;
-	std::vector<uint32_t> prov_color(texture_size * 2);
-	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
-		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto fat_id = dcon::fatten(state.world, prov_id);
-			auto cid = fat_id.get_continent().id.index();
+				population += needs_of(pl.get_pop()) * pl.get_pop().get_size();
 			auto i = province::to_map_id(prov_id);
-			float gradient_index = prov_satisfaction[i];
-			auto color = ogl::color_gradient_viridis(gradient_index);
+			auto color = ogl::color_gradient_viridis(population / state.world.province_get_demographics(prov_id, demographics::total));
 			prov_color[i] = color;
 			prov_color[i + texture_size] = color;
 		}
 	});
 	return prov_color;
 }
-std::vector<uint32_t> luxury_needs_map_from(sys::state& state) {
-	std::vector<float> prov_satisfaction(state.world.province_size() + 1);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
-	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
-		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto fat_id = dcon::fatten(state.world, prov_id);
-			float population = 0.f;
-			for(const auto pl : state.world.province_get_pop_location_as_province(prov_id))
-				population += pop_demographics::get_luxury_needs(state, pl.get_pop()) * pl.get_pop().get_size();
-			auto cid = fat_id.get_continent().id.index();
-			auto i = province::to_map_id(prov_id);
-			prov_satisfaction[i] = population / state.world.province_get_demographics(prov_id, demographics::total);
-		}
-	});
-	uint32_t province_size = state.world.province_size() + 1;
-	uint32_t texture_size = province_size + 256 - province_size % 256;
-	std::vector<uint32_t> prov_color(texture_size * 2);
-	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
-		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto fat_id = dcon::fatten(state.world, prov_id);
-			auto cid = fat_id.get_continent().id.index();
-			auto i = province::to_map_id(prov_id);
-			auto color = ogl::color_gradient_viridis(prov_satisfaction[i]);
-			prov_color[i] = color;
-			prov_color[i + texture_size] = color;
-		}
-	});
-	return prov_color;
+std::vector<uint32_t> life_needs_map_from(sys::state& state, map::map_mode_inputs const& in) {
+	return needs_map_from(state, in, [&](dcon::pop_id p) { return pop_demographics::get_life_needs(state, p); });
 }
-std::vector<uint32_t> life_rating_map_from(sys::state& state) {
+std::vector<uint32_t> everyday_needs_map_from(sys::state& state, map::map_mode_inputs const& in) {
+	return needs_map_from(state, in, [&](dcon::pop_id p) { return pop_demographics::get_everyday_needs(state, p); });
+}
+std::vector<uint32_t> luxury_needs_map_from(sys::state& state, map::map_mode_inputs const& in) {
+	return needs_map_from(state, in, [&](dcon::pop_id p) { return pop_demographics::get_luxury_needs(state, p); });
+}
+std::vector<uint32_t> life_rating_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	std::vector<float> prov_population(state.world.province_size() + 1);
 	std::unordered_map<int32_t, float> continent_max_pop = {};
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
@@ -530,10 +425,10 @@ std::vector<uint32_t> life_rating_map_from(sys::state& state) {
 	});
 	return prov_color;
 }
-std::vector<uint32_t> officers_map_from(sys::state& state) {
+std::vector<uint32_t> officers_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	std::vector<float> prov_population(state.world.province_size() + 1);
 	std::unordered_map<int32_t, float> continent_max_pop = {};
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
@@ -562,11 +457,11 @@ std::vector<uint32_t> officers_map_from(sys::state& state) {
 	});
 	return prov_color;
 }
-std::vector<uint32_t> ctc_map_from(sys::state& state) {
+std::vector<uint32_t> ctc_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
@@ -586,14 +481,14 @@ std::vector<uint32_t> ctc_map_from(sys::state& state) {
 	});
 	return prov_color;
 }
-std::vector<uint32_t> crime_map_from(sys::state& state) {
+std::vector<uint32_t> crime_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		dcon::crime_id cmp_crime;
-		if(state.map_state.get_selected_province()) {
-			cmp_crime = state.world.province_get_crime(state.map_state.get_selected_province());
+		if(in.selection) {
+			cmp_crime = state.world.province_get_crime(in.selection);
 		}
 		auto i = province::to_map_id(prov_id);
 		if(auto crime = state.world.province_get_crime(prov_id); crime && (!cmp_crime || crime == cmp_crime)) {
@@ -618,10 +513,10 @@ std::vector<uint32_t> rally_map_from(sys::state& state) {
 	});
 	return prov_color;
 }
-std::vector<uint32_t> mobilization_map_from(sys::state& state) {
+std::vector<uint32_t> mobilization_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	std::vector<float> prov_population(state.world.province_size() + 1);
 	std::unordered_map<int32_t, float> continent_max_pop = {};
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
@@ -656,15 +551,15 @@ std::vector<uint32_t> mobilization_map_from(sys::state& state) {
 	});
 	return prov_color;
 }
-std::vector<uint32_t> workforce_map_from(sys::state& state) {
+std::vector<uint32_t> workforce_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size() + 1;
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	if(state.map_state.get_selected_province()) {
+	if(in.selection) {
 		dcon::pop_type_fat_id fat_id = dcon::fatten(state.world, dcon::pop_type_id{});
 		float pt_max = 0.f;
 		for(const auto pt : state.world.in_pop_type) {
-			auto total = state.world.province_get_demographics(state.map_state.get_selected_province(), demographics::to_key(state, pt));
+			auto total = state.world.province_get_demographics(in.selection, demographics::to_key(state, pt));
 			if(total > pt_max) {
 				fat_id = pt;
 				total = pt_max;
@@ -679,8 +574,8 @@ std::vector<uint32_t> workforce_map_from(sys::state& state) {
 			}
 			state.world.for_each_province([&](dcon::province_id prov_id) {
 				auto i = province::to_map_id(prov_id);
-				float total = state.world.province_get_demographics(state.map_state.get_selected_province(), demographics::total);
-				float value = state.world.province_get_demographics(state.map_state.get_selected_province(), demographics::to_key(state, fat_id));
+				float total = state.world.province_get_demographics(in.selection, demographics::total);
+				float value = state.world.province_get_demographics(in.selection, demographics::to_key(state, fat_id));
 				auto ratio = value / total;
 				auto color = ogl::color_gradient(ratio, full_color, empty_color);
 				prov_color[i] = color;
@@ -775,12 +670,190 @@ std::vector<uint32_t> select_states_map_from(sys::state& state) {
 
 namespace map_mode {
 
+uint8_t inputs_of(mode mode) {
+	switch(mode) {
+	case mode::terrain:
+	case mode::handled_from_outside:
+		return input::none;
+	case mode::state_select:
+		return input::ui_state;
+	case mode::political:
+	case mode::region:
+	case mode::rank:
+	case mode::recruitment:
+	case mode::supply:
+	case mode::civilization_level:
+	case mode::infrastructure:
+	case mode::party_loyalty:
+	case mode::naval:
+	case mode::national_focus:
+	case mode::crisis:
+	case mode::colonial:
+	case mode::fort:
+	case mode::players:
+	case mode::rally:
+		return input::game_state;
+	default:
+		return uint8_t(input::selection | input::game_state);
+	}
+}
+
+static std::vector<uint32_t> colors_from(sys::state& state, mode mode, map::map_mode_inputs const& in) {
+	switch(mode) {
+	case mode::state_select:
+		return select_states_map_from(state);
+	case mode::political:
+		return political_map_from(state);
+	case mode::region:
+		return region_map_from(state);
+	case mode::population:
+		return population_map_from(state, in);
+	case mode::nationality:
+		return nationality_map_from(state, in);
+	case mode::sphere:
+		return sphere_map_from(state, in);
+	case mode::diplomatic:
+		return diplomatic_map_from(state, in);
+	case mode::rank:
+		return rank_map_from(state);
+	case mode::recruitment:
+		return recruitment_map_from(state, in);
+	case mode::supply:
+		return supply_map_from(state);
+	case mode::relation:
+		return relation_map_from(state, in);
+	case mode::civilization_level:
+		return civilization_level_map_from(state);
+	case mode::migration:
+		return migration_map_from(state, in);
+	case mode::infrastructure:
+		return infrastructure_map_from(state, in);
+	case mode::revolt:
+		return revolt_map_from(state, in);
+	case mode::party_loyalty:
+		return party_loyalty_map_from(state);
+	case mode::admin:
+		return admin_map_from(state, in);
+	case mode::naval:
+		return naval_map_from(state, in);
+	case mode::national_focus:
+		return national_focus_map_from(state, in);
+	case mode::crisis:
+		return crisis_map_from(state);
+	case mode::colonial:
+		return colonial_map_from(state, in);
+	case mode::rgo_output:
+		return rgo_output_map_from(state, in);
+	case mode::religion:
+		return religion_map_from(state, in);
+	case mode::issues:
+		return issue_map_from(state, in);
+	case mode::ideology:
+		return ideology_map_from(state, in);
+	case mode::fort:
+		return fort_map_from(state, in);
+	case mode::income:
+		return income_map_from(state, in);
+	case mode::conciousness:
+		return con_map_from(state, in);
+	case mode::militancy:
+		return militancy_map_from(state, in);
+	case mode::literacy:
+		return literacy_map_from(state, in);
+	case mode::employment:
+		return employment_map_from(state, in);
+	case mode::factories:
+		return factory_map_from(state, in);
+	case mode::growth:
+		return growth_map_from(state, in);
+	//even newer mapmodes
+	case mode::players:
+		return players_map_from(state);
+	case mode::life_needs:
+		return life_needs_map_from(state, in);
+	case mode::everyday_needs:
+		return everyday_needs_map_from(state, in);
+	case mode::luxury_needs:
+		return luxury_needs_map_from(state, in);
+	case mode::life_rating:
+		return life_rating_map_from(state, in);
+	case mode::clerk_to_craftsmen_ratio:
+		return ctc_map_from(state, in);
+	case mode::crime:
+		return crime_map_from(state, in);
+	case mode::rally:
+		return rally_map_from(state);
+	case mode::officers:
+		return officers_map_from(state, in);
+	case mode::mobilization:
+		return mobilization_map_from(state, in);
+	case mode::workforce:
+		return workforce_map_from(state, in);
+	default:
+		return std::vector<uint32_t>{};
+	}
+
+}
+
+static bool is_current(sys::state& state, map::map_mode_colors const& entry, mode mode) {
+	auto inputs = inputs_of(mode);
+	if(!entry.valid || (inputs & input::ui_state) != 0)
+		return false;
+	if(entry.vassal_color != state.user_settings.vassal_color || entry.color_blind != state.user_settings.color_blind_mode)
+		return false;
+	if((inputs & input::selection) != 0 && entry.selection != state.map_state.get_selected_province())
+		return false;
+	if((inputs & input::game_state) != 0 && (entry.generation != state.map_state.map_modes.generation || entry.player != state.local_player_nation))
+		return false;
+	return true;
+}
+
+static void start_map_mode_worker(sys::state& state, mode mode) {
+	auto& cache = state.map_state.map_modes;
+	cache.back_mode = mode;
+	cache.back.selection = state.map_state.get_selected_province();
+	cache.back.player = state.local_player_nation;
+	cache.back.generation = cache.generation;
+	cache.back.vassal_color = state.user_settings.vassal_color;
+	cache.back.color_blind = state.user_settings.color_blind_mode;
+	cache.back.valid = true;
+	cache.worker_done.store(false, std::memory_order::release);
+	// the worker only sees the selection and player the colors will be cached under, never the live ones
+	map::map_mode_inputs in{ cache.back.selection, cache.back.player };
+	cache.worker = std::thread([&state, mode, in]() {
+		auto& cache = state.map_state.map_modes;
+		cache.back.colors = colors_from(state, mode, in);
+		cache.worker_done.store(true, std::memory_order::release);
+	});
+}
+
+// shows the cached colors of a map mode if they are current, otherwise rebuilds them on the worker
+static void request_map_mode(sys::state& state, mode mode) {
+	// modes reading ui state (such as the state selection) are only ever built on the render thread
+	if((inputs_of(mode) & input::ui_state) != 0) {
+		state.map_state.set_province_color(colors_from(state, mode, map::map_mode_inputs{ state.map_state.get_selected_province(), state.local_player_nation }), mode);
+		return;
+	}
+	auto& cache = state.map_state.map_modes;
+	auto& entry = cache.modes[uint8_t(mode)];
+	if(is_current(state, entry, mode)) {
+		if(!entry.colors.empty())
+			state.map_state.set_province_color(entry.colors, mode);
+		return;
+	}
+	if(cache.worker.joinable()) {
+		// picked up by collect_map_mode once the running build is done
+		cache.update_queued = true;
+		return;
+	}
+	start_map_mode_worker(state, mode);
+}
+
 void set_map_mode(sys::state& state, mode mode) {
 	if(mode == map_mode::mode::handled_from_outside) {
 		return;
 	}
 
-	std::vector<uint32_t> prov_color;
 	switch(mode) {
 		case map_mode::mode::migration:
 		case map_mode::mode::population:
@@ -861,148 +934,19 @@ void set_map_mode(sys::state& state, mode mode) {
 			state.ui_state.map_rec_legend->set_visible(state, false);
 	}
 
-	switch(mode) {
-	case mode::state_select:
-		prov_color = select_states_map_from(state);
-		break;
-	case mode::terrain:
+	auto& cache = state.map_state.map_modes;
+	cache.target = mode;
+	if(mode == mode::terrain) {
 		state.map_state.set_terrain_map_mode();
 		return;
-	case mode::political:
-		prov_color = political_map_from(state);
-		break;
-	case mode::region:
-		prov_color = region_map_from(state);
-		break;
-	case mode::population:
-		prov_color = population_map_from(state);
-		break;
-	case mode::nationality:
-		prov_color = nationality_map_from(state);
-		break;
-	case mode::sphere:
-		prov_color = sphere_map_from(state);
-		break;
-	case mode::diplomatic:
-		prov_color = diplomatic_map_from(state);
-		break;
-	case mode::rank:
-		prov_color = rank_map_from(state);
-		break;
-	case mode::recruitment:
-		prov_color = recruitment_map_from(state);
-		break;
-	case mode::supply:
-		prov_color = supply_map_from(state);
-		break;
-	case mode::relation:
-		prov_color = relation_map_from(state);
-		break;
-	case mode::civilization_level:
-		prov_color = civilization_level_map_from(state);
-		break;
-	case mode::migration:
-		prov_color = migration_map_from(state);
-		break;
-	case mode::infrastructure:
-		prov_color = infrastructure_map_from(state);
-		break;
-	case mode::revolt:
-		prov_color = revolt_map_from(state);
-		break;
-	case mode::party_loyalty:
-		prov_color = party_loyalty_map_from(state);
-		break;
-	case mode::admin:
-		prov_color = admin_map_from(state);
-		break;
-	case mode::naval:
-		prov_color = naval_map_from(state);
-		break;
-	case mode::national_focus:
-		prov_color = national_focus_map_from(state);
-		break;
-	case mode::crisis:
-		prov_color = crisis_map_from(state);
-		break;
-	case mode::colonial:
-		prov_color = colonial_map_from(state);
-		break;
-	case mode::rgo_output:
-		prov_color = rgo_output_map_from(state);
-		break;
-	case mode::religion:
-		prov_color = religion_map_from(state);
-		break;
-	case mode::issues:
-		prov_color = issue_map_from(state);
-		break;
-	case mode::ideology:
-		prov_color = ideology_map_from(state);
-		break;
-	case mode::fort:
-		prov_color = fort_map_from(state);
-		break;
-	case mode::income:
-		prov_color = income_map_from(state);
-		break;
-	case mode::conciousness:
-		prov_color = con_map_from(state);
-		break;
-	case mode::militancy:
-		prov_color = militancy_map_from(state);
-		break;
-	case mode::literacy:
-		prov_color = literacy_map_from(state);
-		break;
-	case mode::employment:
-		prov_color = employment_map_from(state);
-		break;
-	case mode::factories:
-		prov_color = factory_map_from(state);
-		break;
-	case mode::growth:
-		prov_color = growth_map_from(state);
-		break;
-	//even newer mapmodes
-	case mode::players:
-		prov_color = players_map_from(state);
-		break;
-	case mode::life_needs:
-		prov_color = life_needs_map_from(state);
-		break;
-	case mode::everyday_needs:
-		prov_color = everyday_needs_map_from(state);
-		break;
-	case mode::luxury_needs:
-		prov_color = luxury_needs_map_from(state);
-		break;
-	case mode::life_rating:
-		prov_color = life_rating_map_from(state);
-		break;
-	case mode::clerk_to_craftsmen_ratio:
-		prov_color = ctc_map_from(state);
-		break;
-	case mode::crime:
-		prov_color = crime_map_from(state);
-		break;
-	case mode::rally:
-		prov_color = rally_map_from(state);
-		break;
-	case mode::officers:
-		prov_color = officers_map_from(state);
-		break;
-	case mode::mobilization:
-		prov_color = mobilization_map_from(state);
-		break;
-	case mode::workforce:
-		prov_color = workforce_map_from(state);
-		break;
-	default:
+	}
+	if((inputs_of(mode) & input::ui_state) != 0) {
+		request_map_mode(state, mode);
 		return;
 	}
-
-	state.map_state.set_province_color(prov_color, mode);
+	// the previous colors stay on screen until the new ones are ready
+	state.map_state.active_map_mode = mode;
+	request_map_mode(state, mode);
 }
 
 void update_map_mode(sys::state& state) {
@@ -1015,4 +959,35 @@ void update_map_mode(sys::state& state) {
 	}
 	set_map_mode(state, state.map_state.active_map_mode);
 }
+
+void collect_map_mode(sys::state& state) {
+	auto& cache = state.map_state.map_modes;
+	if(!cache.worker.joinable() || !cache.worker_done.load(std::memory_order::acquire))
+		return;
+	cache.worker.join();
+	// the replaced colors become the next back buffer
+	std::swap(cache.modes[uint8_t(cache.back_mode)], cache.back);
+	auto target = cache.target;
+	// ui state modes were already built synchronously by set_map_mode, don't overwrite them
+	if(target == mode::terrain || target == mode::handled_from_outside || (inputs_of(target) & input::ui_state) != 0) {
+		cache.update_queued = false;
+		return;
+	}
+	if(cache.update_queued || target != cache.back_mode) {
+		cache.update_queued = false;
+		request_map_mode(state, target);
+	} else if(!cache.modes[uint8_t(target)].colors.empty()) {
+		state.map_state.set_province_color(cache.modes[uint8_t(target)].colors, target);
+	}
+}
+
+void discard_map_mode_colors(sys::state& state) {
+	auto& cache = state.map_state.map_modes;
+	if(cache.worker.joinable())
+		cache.worker.join();
+	cache.update_queued = false;
+	cache.back.valid = false;
+	for(auto& entry : cache.modes)
+		entry.valid = false;
+}
 } // namespace map_mode
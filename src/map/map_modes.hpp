@@ -56,6 +56,19 @@ enum class mode : uint8_t {
 
 const uint8_t PROV_COLOR_LAYERS = 2;
 
+// what the colors of a map mode are computed from, cached colors are reused until one of these changes
+namespace input {
+inline constexpr uint8_t none = 0x00;
+inline constexpr uint8_t selection = 0x01; // the selected province
+inline constexpr uint8_t game_state = 0x02; // anything that may change during a game state update
+inline constexpr uint8_t ui_state = 0x04; // state owned by the render thread, computed there and never cached
+} // namespace input
+
+uint8_t inputs_of(mode mode);
 void set_map_mode(sys::state& state, mode mode);
 void update_map_mode(sys::state& state);
+// called every frame on the render thread to show map mode colors finished by the worker
+void collect_map_mode(sys::state& state);
+// waits for a running build and forgets all cached colors, must be called before the world is reloaded
+void discard_map_mode_colors(sys::state& state);
 } // namespace map_mode
@@ -13,6 +13,7 @@
 
 
 #include <set>
+#include <algorithm>
 
 namespace map {
 
@@ -800,42 +801,599 @@ dcon::nation_id get_top_overlord(sys::state& state, dcon::nation_id n) {
 	return ol_temp;
 }
 
-void update_text_lines(sys::state& state, display_data& map_data) {
-	auto& f = state.font_collection.get_font(state, text::font_selection::map_font);
-
-	// retroscipt
-	std::vector<text_line_generator_data> text_data;
-	std::vector<bool> visited(65536, false);
-	std::vector<bool> visited_sea_provinces(65536, false);
-	std::vector<bool> friendly_sea_provinces(65536, false);
-	std::vector<uint16_t> group_of_regions;
-
-	std::unordered_map<uint16_t, std::set<uint16_t>> regions_graph;
+// fits the label curve of one group; runs on the worker, so it only reads the task and the static map data
+static void fit_text_line(display_data const& map_data, std::vector<int32_t> const& province_group, sys::map_label_mode mode, text_line_task& task) {
+	auto& fit = task.fit;
 
 	int samples_N = 200;
 	int samples_M = 100;
 	float step_x = float(map_data.size_x) / float(samples_N);
 	float step_y = float(map_data.size_y) / float(samples_M);
 
-	// generate additional points
-	/*std::vector<uint16_t> samples_regions;
-	for(int i = 0; i < samples_N; i++)
-		for(int j = 0; j < samples_M; j++) {
-			float x = float(i) * step_x;
-			float y = float(map_data.size_y) - float(j) * step_y;
+	float rough_box_left = std::numeric_limits<float>::max();
+	float rough_box_right = 0;
+	float rough_box_bottom = std::numeric_limits<float>::max();
+	float rough_box_top = 0;
+
+	for(auto mid_point : task.mid_points) {
+		if(mid_point.x < rough_box_left) {
+			rough_box_left = mid_point.x;
+		}
+		if(mid_point.x > rough_box_right) {
+			rough_box_right = mid_point.x;
+		}
+		if(mid_point.y < rough_box_bottom) {
+			rough_box_bottom = mid_point.y;
+		}
+		if(mid_point.y > rough_box_top) {
+			rough_box_top = mid_point.y;
+		}
+	}
+
+	if(rough_box_right - rough_box_left > map_data.size_x * 0.9f) {
+		return;
+	}
+
+
+	std::vector<glm::vec2> points;
+	std::vector<glm::vec2> bad_points;
+
+	rough_box_bottom = std::max(0.f, rough_box_bottom - step_y);
+	rough_box_top = std::min(float(map_data.size_y), rough_box_top + step_y);
+	rough_box_left = std::max(0.f, rough_box_left - step_x);
+	rough_box_right = std::min(float(map_data.size_x), rough_box_right + step_x);
+
+	float rough_box_width = rough_box_right - rough_box_left;
+	float rough_box_height = rough_box_top - rough_box_bottom;
+
+	float rough_box_ratio = rough_box_width / rough_box_height;
+	float height_steps = 15.f;
+	float width_steps = std::max(10.f, height_steps * rough_box_ratio);
+
+	glm::vec2 local_step = glm::vec2(rough_box_width, rough_box_height) / glm::vec2(width_steps, height_steps);
+
+	float best_y = 0.f;
+	//float best_y_length = 0.f;
+	float counter_from_the_bottom = 0.f;
+	float best_y_length_real = 0.f;
+	float best_y_left_x = 0.f;
+
+	// prepare points for a local grid
+	for(int j = 0; j < height_steps; j++) {
+		float y = rough_box_bottom + j * local_step.y;
+
+		for(int i = 0; i < width_steps; i++) {
+			float x = rough_box_left + float(i) * local_step.x;
+			glm::vec2 candidate = { x, y };
 			auto idx = int32_t(y) * int32_t(map_data.size_x) + int32_t(x);
+			if(0 <= idx && size_t(idx) < map_data.province_id_map.size()) {
+				if(auto map_id = map_data.province_id_map[idx]; map_id < province_group.size() && province_group[map_id] == task.group) {
+					points.push_back(candidate);
+				}
+			}
+		}
+	}
 
+	float points_above = 0.f;
+
+	for(int j = 0; j < height_steps; j++) {
+		float y = rough_box_bottom + j * local_step.y;
+
+		float current_length = 0.f;
+		float left_x = (float)(map_data.size_x);
+
+		for(int i = 0; i < width_steps; i++) {
+			float x = rough_box_left + float(i) * local_step.x;
+
+			glm::vec2 candidate = { x, y };
+
+			auto idx = int32_t(y) * int32_t(map_data.size_x) + int32_t(x);
 			if(0 <= idx && size_t(idx) < map_data.province_id_map.size()) {
-				auto fat_id = dcon::fatten(state.world, province::from_map_id(map_data.province_id_map[idx]));
-				samples_regions.push_back(fat_id.get_connected_region_id());
-			} else {
-				samples_regions.push_back(0);
+				if(auto map_id = map_data.province_id_map[idx]; map_id < province_group.size() && province_group[map_id] == task.group) {
+					points_above++;
+					current_length += local_step.x;
+					if(x < left_x) {
+						left_x = x;
+					}
+				}
 			}
-		}*/
+		}
+
+		if(points_above * 2.f > points.size()) {
+			//best_y_length = current_length_adjusted;
+			best_y_length_real = current_length;
+			best_y = y;
+			best_y_left_x = left_x;
+			break;
+		}
+	}
+
+	if(points.size() < 2) {
+		return;
+	}
+
+	// clustering points into num_of_clusters parts
+	size_t min_amount = 2;
+	if(mode == sys::map_label_mode::cubic) {
+		min_amount = 4;
+	}
+	if(mode == sys::map_label_mode::quadratic) {
+		min_amount = 3;
+	}
+	size_t num_of_clusters = std::max(min_amount, (size_t)(points.size() / 40));
+	size_t neighbours_requirement = std::clamp(int(std::log(num_of_clusters + 1)), 1, 3);
+
+	if(points.size() < num_of_clusters) {
+		num_of_clusters = points.size();
+	}
+
+	std::vector<glm::vec2> centroids;
+
+	for(size_t i = 0; i < num_of_clusters; i++) {
+		centroids.push_back(points[i]);
+	}
+
+	for(int step = 0; step < 100; step++) {
+		std::vector<glm::vec2> new_centroids;
+		std::vector<int> counters;
+		for(size_t i = 0; i < num_of_clusters; i++) {
+			new_centroids.push_back(glm::vec2(0, 0));
+			counters.push_back(0);
+		}
+
+
+		for(size_t i = 0; i < points.size(); i++) {
+			size_t closest = 0;
+			float best_dist = std::numeric_limits<float>::max();
+
+			//finding the closest centroid
+			for(size_t cluster = 0; cluster < num_of_clusters; cluster++) {
+				if(best_dist > glm::distance(centroids[cluster], points[i])) {
+					closest = cluster;
+					best_dist = glm::distance(centroids[cluster], points[i]);
+				}
+			}
+
+			new_centroids[closest] += points[i];
+			counters[closest] += 1;
+		}
+
+		for(size_t i = 0; i < num_of_clusters; i++) {
+			new_centroids[i] /= counters[i];
+		}
+
+		centroids = new_centroids;
+	}
+
+	std::vector<size_t> good_centroids;
+	float min_cross = 1;
+
+	std::vector<glm::vec2> final_points;
+
+	for(size_t i = 0; i < num_of_clusters; i++) {
+		float locally_good_distance = std::numeric_limits<float>::max();
+		for(size_t j = 0; j < num_of_clusters; j++) {
+			if(i == j) continue;
+			if(locally_good_distance > glm::distance(centroids[i], centroids[j]))
+				locally_good_distance = glm::distance(centroids[i], centroids[j]);
+		}
+
+		size_t counter_of_neighbors = 0;
+		for(size_t j = 0; j < num_of_clusters; j++) {
+			if(i == j) {
+				continue;
+			}
+			if(glm::distance(centroids[i], centroids[j]) < locally_good_distance * 1.2f) {
+				counter_of_neighbors++;
+			}
+		}
+		if(counter_of_neighbors >= neighbours_requirement) {
+			good_centroids.push_back(i);
+			final_points.push_back(centroids[i]);
+		}
+	}
+
+
+	if(good_centroids.size() <= 1) {
+		good_centroids.clear();
+		final_points.clear();
+		for(size_t i = 0; i < num_of_clusters; i++) {
+			good_centroids.push_back(i);
+			final_points.push_back(centroids[i]);
+		}
+	}
+
+	//throwing away bad cluster
+
+	std::vector<glm::vec2> good_points;
+
+	glm::vec2 sum_points = { 0.f, 0.f };
+
+	//OutputDebugStringA("\n\n");
+
+	for(auto point : points) {
+		size_t closest = 0;
+		float best_dist = std::numeric_limits<float>::max();
+
+		//finding the closest centroid
+		for(size_t cluster = 0; cluster < num_of_clusters; cluster++) {
+			if(best_dist > glm::distance(centroids[cluster], point)) {
+				closest = cluster;
+				best_dist = glm::distance(centroids[cluster], point);
+			}
+		}
+
+
+		bool is_good = false;
+		for(size_t i = 0; i < good_centroids.size(); i++) {
+			if(closest == good_centroids[i])
+				is_good = true;
+		}
+
+		if (is_good) {
+			good_points.push_back(point);
+			sum_points += point;
+		}
+	}
+
+	points = good_points;
+	
+
+	//initial center:
+	glm::vec2 center = sum_points / (float)(points.size());
+
+	//calculate deviation
+	float total_sum = 0;
+
+	for(auto point : points) {
+		auto dif_v = point - center;
+		total_sum += dif_v.x * dif_v.x;
+	}
+
+	float mse = total_sum / points.size();
+	//ignore points beyond 3 std
+	float limit = mse * 3;
+
+	//calculate radius
+	//OutputDebugStringA("\n");
+	//OutputDebugStringA("\n");
+	float right = 0.f;
+	float left = 0.f;
+	float top = 0.f;
+	float bottom = 0.f;
+	for(auto point: points) {
+		//OutputDebugStringA((std::to_string(point.x) + ", " + std::to_string(point.y) + ", \n").c_str());
+		glm::vec2 current = point - center;
+		if((current.x > right) && (current.x * current.x < limit)) {
+			right = current.x;
+		}
+		if(current.y > top) {
+			top = current.y;
+		}
+		if((current.x < left) && (current.x * current.x < limit)) {
+			left = current.x;
+		}
+		if(current.y < bottom) {
+			bottom = current.y;
+		}
+	}
+
+	std::vector<glm::vec2> key_points;
+
+	key_points.push_back(center + glm::vec2(left, 0));
+	key_points.push_back(center + glm::vec2(0, bottom + local_step.y));
+	key_points.push_back(center + glm::vec2(right, 0));
+	key_points.push_back(center + glm::vec2(0, top - local_step.y));
+
+	std::array<glm::vec2, 5> key_provs{
+		center, //capital
+		center, //min x
+		center, //min y
+		center, //max x
+		center //max y
+	};
+
+	for(auto key_point : key_points) {
+		//if (glm::length(key_point - center) < 100.f * glm::length(eigenvector_1)) 
+		update_bbox(key_provs, key_point);
+	}
+
+
+	glm::vec2 map_size{ float(map_data.size_x), float(map_data.size_y) };
+	glm::vec2 basis{ key_provs[1].x, key_provs[2].y };
+	glm::vec2 ratio{ key_provs[3].x - key_provs[1].x, key_provs[4].y - key_provs[2].y };
+
+	if(ratio.x < 0.001f || ratio.y < 0.001f)
+		return;
+
+	points = final_points;
+
+	//regularisation parameters
+	float lambda = 0.00001f;
+
+	float l_0 = 1.f;
+	float l_1 = 1.f;
+	float l_2 = 1 / 4.f;
+	float l_3 = 1 / 8.f;
+
+	// Populate common dataset points
+	std::vector<float> out_y;
+	std::vector<float> out_x;
+	std::vector<float> w;
+	std::vector<std::array<float, 4>> in_x;
+	std::vector<std::array<float, 4>> in_y;
+
+	for (auto point : points) {
+		auto e = point;
+
+		if(e.x < basis.x) {
+			continue;
+		}
+		if(e.x > basis.x + ratio.x) {
+			continue;
+		}
+
+		w.push_back(1);
+
+		e -= basis;
+		e /= ratio;
+		out_y.push_back(e.y);
+		out_x.push_back(e.x);
+		//w.push_back(10 * float(map_data.province_area[province::to_map_id(p2)]));
+				
+		in_x.push_back(std::array<float, 4>{ l_0 * 1.f, l_1* e.x, l_1* e.x* e.x, l_3* e.x* e.x* e.x});
+		in_y.push_back(std::array<float, 4>{ l_0 * 1.f, l_1* e.y, l_1* e.y* e.y, l_3* e.y* e.y* e.y});
+	}
+
+	float name_extent = task.fit.name_extent;
+
+	bool use_quadratic = false;
+	// We will try cubic regression first, if that results in very
+	// weird lines, for example, lines that go to the infinite
+	// we will "fallback" to using a quadratic instead
+	if(mode == sys::map_label_mode::cubic) {
+		// Columns -> n
+		// Rows -> fixed size of 4
+		// [ x0^0 x0^1 x0^2 x0^3 ]
+		// [ x1^0 x1^1 x1^2 x1^3 ]
+		// [ ...  ...  ...  ...  ]
+		// [ xn^0 xn^1 xn^2 xn^3 ]
+		// [AB]i,j = sum(n, r=1, a_(i,r) * b(r,j))
+		// [ x0^0 x0^1 x0^2 x0^3 ] * [ x0^0 x1^0 ... xn^0 ] = [ a0 a1 a2 ... an ]
+		// [ x1^0 x1^1 x1^2 x1^3 ] * [ x0^1 x1^1 ... xn^1 ] = [ b0 b1 b2 ... bn ]
+		// [ ...  ...  ...  ...  ] * [ x0^2 x1^2 ... xn^2 ] = [ c0 c1 c2 ... cn ]
+		// [ xn^0 xn^1 xn^2 xn^3 ] * [ x0^3 x1^3 ... xn^3 ] = [ d0 d1 d2 ... dn ]
+		glm::mat4x4 m0(0.f);
+		for(glm::length_t i = 0; i < m0.length(); i++)
+			for(glm::length_t j = 0; j < m0.length(); j++)
+				for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
+					m0[i][j] += in_x[r][j] * w[r] * in_x[r][i] / in_x.size();
+		for(glm::length_t i = 0; i < m0.length(); i++)
+			m0[i][i] += lambda;
+		m0 = glm::inverse(m0); // m0 = (T(X)*X/n + I*lambda)^-1
+		glm::vec4 m1(0.f); // m1 = T(X)*Y / n
+		for(glm::length_t i = 0; i < m1.length(); i++)
+			for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
+				m1[i] += in_x[r][i] * w[r] * out_y[r] / in_x.size();
+		glm::vec4 mo(0.f); // mo = m1 * m0
+		for(glm::length_t i = 0; i < mo.length(); i++)
+			for(glm::length_t j = 0; j < mo.length(); j++)
+				mo[i] += m0[i][j] * m1[j];
+		// y = a + bx + cx^2 + dx^3
+		// y = mo[0] + mo[1] * x + mo[2] * x * x + mo[3] * x * x * x
+		auto poly_fn = [&](float x) {
+			return mo[0] * l_0 + mo[1] * x * l_1 + mo[2] * x * x * l_2 + mo[3] * x * x * x * l_3;
+		};
+		auto dx_fn = [&](float x) {
+			return mo[1] * l_1 + 2.f * mo[2] * x * l_2 + 3.f * mo[3] * x * x * l_3;
+		};
+		auto error_grad = [&](float x, float y) {
+			float error_linear = poly_fn(x) - y;				
+			return glm::vec4(error_linear * error_linear * error_linear * error_linear * error_linear * mo);
+		};
+
+		auto regularisation_grad = [&]() {
+			return glm::vec4(0, 0, mo[2] / 4.f, mo[3] / 6.f);
+		};
+
+		float xstep = (1.f / float(name_extent * 2.f));
+		for(float x = 0.f; x <= 1.f; x += xstep) {
+			float y = poly_fn(x);
+			if(y < 0.f || y > 1.f) {
+				use_quadratic = true;
+				break;
+			}
+			// Steep change in curve => use cuadratic
+			float dx = glm::abs(dx_fn(x) - dx_fn(x - xstep));
+			if(dx / xstep >= 0.45f) {
+				use_quadratic = true;
+				break;
+			}
+		}			
+
+		if(!use_quadratic) {
+			fit.has_line = true;
+			fit.coeff = mo;
+			fit.basis = basis;
+			fit.ratio = ratio;
+		}
+	}
+
+	bool use_linear = false;
+	if(mode == sys::map_label_mode::quadratic || use_quadratic) {
+		// Now lets try quadratic
+		glm::mat3x3 m0(0.f);
+		for(glm::length_t i = 0; i < m0.length(); i++)
+			for(glm::length_t j = 0; j < m0.length(); j++)
+				for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
+					m0[i][j] += in_x[r][j] * w[r] * in_x[r][i] / in_x.size();
+		for(glm::length_t i = 0; i < m0.length(); i++)
+			m0[i][i] += lambda;
+		m0 = glm::inverse(m0); // m0 = (T(X)*X)^-1
+		glm::vec3 m1(0.f); // m1 = T(X)*Y
+		for(glm::length_t i = 0; i < m1.length(); i++)
+			for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
+				m1[i] += in_x[r][i] * w[r] * out_y[r] / in_x.size();
+		glm::vec3 mo(0.f); // mo = m1 * m0
+		for(glm::length_t i = 0; i < mo.length(); i++)
+			for(glm::length_t j = 0; j < mo.length(); j++)
+				mo[i] += m0[i][j] * m1[j];
+		// y = a + bx + cx^2
+		// y = mo[0] + mo[1] * x + mo[2] * x * x
+		auto poly_fn = [&](float x) {
+			return mo[0] * l_0 + mo[1] * x * l_1 + mo[2] * x * x * l_2;
+		};
+		auto dx_fn = [&](float x) {
+			return mo[1] * l_1 + 2.f * mo[2] * x * l_2;
+		};
+		float xstep = (1.f / float(name_extent * 2.f));
+		for(float x = 0.f; x <= 1.f; x += xstep) {
+			float y = poly_fn(x);
+			if(y < 0.f || y > 1.f) {
+				use_linear = true;
+				break;
+			}
+			// Steep change in curve => use cuadratic
+			float dx = glm::abs(dx_fn(x) - dx_fn(x - xstep));
+			if(dx / xstep >= 0.45f) {
+				use_linear = true;
+				break;
+			}
+		}
+		if(!use_linear) {
+			fit.has_line = true;
+			fit.coeff = glm::vec4(mo, 0.f);
+			fit.basis = basis;
+			fit.ratio = ratio;
+		}
+	}
+
+	if(mode == sys::map_label_mode::linear || use_linear) {
+		// Now lets try linear
+		glm::mat2x2 m0(0.f);
+		for(glm::length_t i = 0; i < m0.length(); i++)
+			for(glm::length_t j = 0; j < m0.length(); j++)
+				for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
+					m0[i][j] += in_x[r][j] * w[r] * in_x[r][i];
+		for(glm::length_t i = 0; i < m0.length(); i++)
+			m0[i][i] += lambda;
+		m0 = glm::inverse(m0); // m0 = (T(X)*X)^-1
+		glm::vec2 m1(0.f); // m1 = T(X)*Y
+		for(glm::length_t i = 0; i < m1.length(); i++)
+			for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
+				m1[i] += in_x[r][i] * w[r] * out_y[r];
+		glm::vec2 mo(0.f); // mo = m1 * m0
+		for(glm::length_t i = 0; i < mo.length(); i++)
+			for(glm::length_t j = 0; j < mo.length(); j++)
+				mo[i] += m0[i][j] * m1[j];
+
+		// y = a + bx
+		// y = mo[0] + mo[1] * x
+		auto poly_fn = [&](float x) {
+			return mo[0] * l_0 + mo[1] * x * l_1;
+		};
+
+
+		// check if this is really better than taking the longest horizontal
+
+		// firstly check if we are already horizontal
+		if(abs(mo[1]) > 0.05) {
+			// calculate where our line will start and end:
+			float left_side = 0.f;
+			float right_side = 1.f;
+
+			if(mo[1] > 0.01f) {
+				left_side = -mo[0] / mo[1];
+				right_side = (1.f - mo[0]) / mo[1];
+			} else if(mo[1] < -0.01f) {
+				left_side = (1.f - mo[0]) / mo[1];
+				right_side = -mo[0] / mo[1];
+			}
+
+			left_side = std::clamp(left_side, 0.f, 1.f);
+			right_side = std::clamp(right_side, 0.f, 1.f);
+
+			float length_in_box_units = glm::length(ratio * glm::vec2(poly_fn(left_side), poly_fn(right_side)));
+
+			if(best_y_length_real * 1.05f >= length_in_box_units) {
+				basis.x = best_y_left_x;
+				ratio.x = best_y_length_real;
+				mo[0] = (best_y - basis.y) / ratio.y;
+				mo[1] = 0;
+			}
+		}
+
+
+		if(ratio.x <= map_size.x * 0.75f && ratio.y <= map_size.y * 0.75f) {
+			fit.has_line = true;
+			fit.coeff = glm::vec4(mo, 0.f, 0.f);
+			fit.basis = basis;
+			fit.ratio = ratio;
+		}
+	}
+}
+
+// the finished fits stay cached for the next update whether or not they are shown
+static void store_text_line_fits(sys::state& state) {
+	auto& labels = state.map_state.text_lines;
+	for(auto& task : labels.tasks) {
+		labels.fits[task.leader.index()] = std::move(task.fit);
+	}
+	labels.tasks.clear();
+}
+
+static void upload_text_lines(sys::state& state, display_data& map_data) {
+	auto& labels = state.map_state.text_lines;
+	store_text_line_fits(state);
+
+	std::vector<text_line_generator_data> text_data;
+	for(size_t i = 0; i < labels.labelled.size(); ++i) {
+		auto& fit = labels.fits[labels.labelled[i].index()];
+		if(fit.has_line)
+			text_data.emplace_back(std::move(labels.names[i]), fit.coeff, fit.basis, fit.ratio);
+	}
+	labels.labelled.clear();
+	labels.names.clear();
+	map_data.set_text_lines(state, text_data);
+}
+
+void update_text_lines(sys::state& state, display_data& map_data) {
+	auto& labels = state.map_state.text_lines;
+	if(labels.worker.joinable()) {
+		// picked up by collect_text_lines once the running batch is uploaded
+		labels.update_queued = true;
+		return;
+	}
+
+	auto& f = state.font_collection.get_font(state, text::font_selection::map_font);
+
+	if(labels.mode != state.user_settings.map_label) {
+		labels.fits.clear();
+		labels.mode = state.user_settings.map_label;
+	}
+	labels.fits.resize(state.world.province_size());
+	labels.province_group.assign(size_t(state.world.province_size()) + 1, -1);
+	labels.labelled.clear();
+	labels.names.clear();
+	labels.tasks.clear();
+
+	// retroscipt
+	uint16_t max_region = 0;
+	for(auto p : state.world.in_province) {
+		max_region = std::max(max_region, p.get_connected_region_id());
+	}
+	std::vector<bool> visited(size_t(max_region) + 1, false);
+	std::vector<std::vector<uint16_t>> regions_graph(size_t(max_region) + 1);
+	std::vector<std::vector<dcon::province_id>> region_provinces(size_t(max_region) + 1);
+	std::vector<uint16_t> group_of_regions;
+	std::vector<dcon::province_id> group_provinces;
 
 	// generate graph of regions:
 	for(auto candidate : state.world.in_province) {
 		auto rid = candidate.get_connected_region_id();
+		if(candidate.id.index() < state.province_definitions.first_sea_province.index()) {
+			region_provinces[rid].push_back(candidate);
+		}
 
 		auto nation = get_top_overlord(state, state.world.province_get_nation_from_province_ownership(candidate));
 
@@ -858,16 +1416,22 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 					} else if(neighbor_of_neighbor.id.index() < state.province_definitions.first_sea_province.index()) {
 						auto nation_2 = get_top_overlord(state, state.world.province_get_nation_from_province_ownership(neighbor_of_neighbor));
 						if(nation == nation_2)
-							regions_graph[rid].insert(neighbor_of_neighbor.get_connected_region_id());
+							regions_graph[rid].push_back(neighbor_of_neighbor.get_connected_region_id());
 					}
 				}
 			} else {
 				auto nation_2 = get_top_overlord(state, state.world.province_get_nation_from_province_ownership(neighbor));
 				if(nation == nation_2)
-					regions_graph[rid].insert(neighbor.get_connected_region_id());
+					regions_graph[rid].push_back(neighbor.get_connected_region_id());
 			}
 		}
 	}
+	for(auto& neighbours : regions_graph) {
+		std::sort(neighbours.begin(), neighbours.end());
+		neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+	}
+
+	int32_t group = 0;
 	for(auto p : state.world.in_province) {
 		if(p.id.index() >= state.province_definitions.first_sea_province.index())
 			break;
@@ -898,6 +1462,11 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 		if(!n || n.get_owned_province_count() == 0)
 			continue;
 
+		group_provinces.clear();
+		for(auto visited_region : group_of_regions) {
+			group_provinces.insert(group_provinces.end(), region_provinces[visited_region].begin(), region_provinces[visited_region].end());
+		}
+
 		auto nation_name = text::produce_simple_string(state, text::get_name(state, n));
 		auto prefix_remove = text::produce_simple_string(state, "map_remove_prefix");
 		if(nation_name.starts_with(prefix_remove)) {
@@ -932,20 +1501,17 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 			uint32_t total_provinces = 0;
 			dcon::province_id last_province;
 			bool in_same_state = true;
-			for(auto visited_region : group_of_regions) {
-				for(auto candidate : state.world.in_province) {
-					if(candidate.get_connected_region_id() == visited_region) {
-						if(candidate.get_state_membership() != p.get_state_membership())
-							in_same_state = false;
-						++total_provinces;
-						for(const auto core : candidate.get_core_as_province()) {
-							uint32_t v = 1;
-							if(auto const it = map.find(core.get_identity().id.index()); it != map.end()) {
-								v += it->second;
-							}
-							map.insert_or_assign(core.get_identity().id.index(), v);
-						}
+			for(auto candidate_id : group_provinces) {
+				auto candidate = dcon::fatten(state.world, candidate_id);
+				if(candidate.get_state_membership() != p.get_state_membership())
+					in_same_state = false;
+				++total_provinces;
+				for(const auto core : candidate.get_core_as_province()) {
+					uint32_t v = 1;
+					if(auto const it = map.find(core.get_identity().id.index()); it != map.end()) {
+						v += it->second;
 					}
+					map.insert_or_assign(core.get_identity().id.index(), v);
 				}
 			}
 			if(in_same_state == true) {
@@ -1001,529 +1567,41 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 		if(name.empty())
 			continue;
 
-		float rough_box_left = std::numeric_limits<float>::max();
-		float rough_box_right = 0;
-		float rough_box_bottom = std::numeric_limits<float>::max();
-		float rough_box_top = 0;
-
-		for(auto visited_region : group_of_regions) {
-			for(auto candidate : state.world.in_province) {
-				if(candidate.get_connected_region_id() == visited_region) {
-					glm::vec2 mid_point = candidate.get_mid_point();
-
-					if(mid_point.x < rough_box_left) {
-						rough_box_left = mid_point.x;
-					}
-					if(mid_point.x > rough_box_right) {
-						rough_box_right = mid_point.x;
-					}
-					if(mid_point.y < rough_box_bottom) {
-						rough_box_bottom = mid_point.y;
-					}
-					if(mid_point.y > rough_box_top) {
-						rough_box_top = mid_point.y;
-					}
-				}
-			}
-		}
-
-		if(rough_box_right - rough_box_left > map_data.size_x * 0.9f) {
-			continue;
-		}
-
-
-		std::vector<glm::vec2> points;
-		std::vector<glm::vec2> bad_points;
-
-		rough_box_bottom = std::max(0.f, rough_box_bottom - step_y);
-		rough_box_top = std::min(float(map_data.size_y), rough_box_top + step_y);
-		rough_box_left = std::max(0.f, rough_box_left - step_x);
-		rough_box_right = std::min(float(map_data.size_x), rough_box_right + step_x);
-
-		float rough_box_width = rough_box_right - rough_box_left;
-		float rough_box_height = rough_box_top - rough_box_bottom;
-
-		float rough_box_ratio = rough_box_width / rough_box_height;
-		float height_steps = 15.f;
-		float width_steps = std::max(10.f, height_steps * rough_box_ratio);
-
-		glm::vec2 local_step = glm::vec2(rough_box_width, rough_box_height) / glm::vec2(width_steps, height_steps);
-
-		float best_y = 0.f;
-		//float best_y_length = 0.f;
-		float counter_from_the_bottom = 0.f;
-		float best_y_length_real = 0.f;
-		float best_y_left_x = 0.f;
-
-		// prepare points for a local grid
-		for(int j = 0; j < height_steps; j++) {
-			float y = rough_box_bottom + j * local_step.y;
-
-			for(int i = 0; i < width_steps; i++) {
-				float x = rough_box_left + float(i) * local_step.x;
-				glm::vec2 candidate = { x, y };
-				auto idx = int32_t(y) * int32_t(map_data.size_x) + int32_t(x);
-				if(0 <= idx && size_t(idx) < map_data.province_id_map.size()) {
-					auto fat_id = dcon::fatten(state.world, province::from_map_id(map_data.province_id_map[idx]));
-					for(auto visited_region : group_of_regions) {
-						if(fat_id.get_connected_region_id() == visited_region) {
-							points.push_back(candidate);
-						}
-					}
-				}
-			}
-		}
-
-		float points_above = 0.f;
-
-		for(int j = 0; j < height_steps; j++) {
-			float y = rough_box_bottom + j * local_step.y;
-
-			float current_length = 0.f;
-			float left_x = (float)(map_data.size_x);
-
-			for(int i = 0; i < width_steps; i++) {
-				float x = rough_box_left + float(i) * local_step.x;
-
-				glm::vec2 candidate = { x, y };
-
-				auto idx = int32_t(y) * int32_t(map_data.size_x) + int32_t(x);
-				if(0 <= idx && size_t(idx) < map_data.province_id_map.size()) {
-					auto fat_id = dcon::fatten(state.world, province::from_map_id(map_data.province_id_map[idx]));
-					for(auto visited_region : group_of_regions)
-						if(fat_id.get_connected_region_id() == visited_region) {
-							points_above++;
-							current_length += local_step.x;
-							if(x < left_x) {
-								left_x = x;
-							}
-						}
-				}
-			}
-
-			if(points_above * 2.f > points.size()) {
-				//best_y_length = current_length_adjusted;
-				best_y_length_real = current_length;
-				best_y = y;
-				best_y_left_x = left_x;
-				break;
-			}
-		}
-
-		if(points.size() < 2) {
-			continue;
-		}
-
-		// clustering points into num_of_clusters parts
-		size_t min_amount = 2;
-		if(state.user_settings.map_label == sys::map_label_mode::cubic) {
-			min_amount = 4;
-		}
-		if(state.user_settings.map_label == sys::map_label_mode::quadratic) {
-			min_amount = 3;
-		}
-		size_t num_of_clusters = std::max(min_amount, (size_t)(points.size() / 40));
-		size_t neighbours_requirement = std::clamp(int(std::log(num_of_clusters + 1)), 1, 3);
-
-		if(points.size() < num_of_clusters) {
-			num_of_clusters = points.size();
-		}
-
-		std::vector<glm::vec2> centroids;
-
-		for(size_t i = 0; i < num_of_clusters; i++) {
-			centroids.push_back(points[i]);
-		}
-
-		for(int step = 0; step < 100; step++) {
-			std::vector<glm::vec2> new_centroids;
-			std::vector<int> counters;
-			for(size_t i = 0; i < num_of_clusters; i++) {
-				new_centroids.push_back(glm::vec2(0, 0));
-				counters.push_back(0);
-			}
-
-
-			for(size_t i = 0; i < points.size(); i++) {
-				size_t closest = 0;
-				float best_dist = std::numeric_limits<float>::max();
-
-				//finding the closest centroid
-				for(size_t cluster = 0; cluster < num_of_clusters; cluster++) {
-					if(best_dist > glm::distance(centroids[cluster], points[i])) {
-						closest = cluster;
-						best_dist = glm::distance(centroids[cluster], points[i]);
-					}
-				}
-
-				new_centroids[closest] += points[i];
-				counters[closest] += 1;
-			}
-
-			for(size_t i = 0; i < num_of_clusters; i++) {
-				new_centroids[i] /= counters[i];
-			}
-
-			centroids = new_centroids;
-		}
-
-		std::vector<size_t> good_centroids;
-		float min_cross = 1;
-
-		std::vector<glm::vec2> final_points;
-
-		for(size_t i = 0; i < num_of_clusters; i++) {
-			float locally_good_distance = std::numeric_limits<float>::max();
-			for(size_t j = 0; j < num_of_clusters; j++) {
-				if(i == j) continue;
-				if(locally_good_distance > glm::distance(centroids[i], centroids[j]))
-					locally_good_distance = glm::distance(centroids[i], centroids[j]);
-			}
-
-			size_t counter_of_neighbors = 0;
-			for(size_t j = 0; j < num_of_clusters; j++) {
-				if(i == j) {
-					continue;
-				}
-				if(glm::distance(centroids[i], centroids[j]) < locally_good_distance * 1.2f) {
-					counter_of_neighbors++;
-				}
-			}
-			if(counter_of_neighbors >= neighbours_requirement) {
-				good_centroids.push_back(i);
-				final_points.push_back(centroids[i]);
-			}
-		}
-
-
-		if(good_centroids.size() <= 1) {
-			good_centroids.clear();
-			final_points.clear();
-			for(size_t i = 0; i < num_of_clusters; i++) {
-				good_centroids.push_back(i);
-				final_points.push_back(centroids[i]);
-			}
-		}
-
-		//throwing away bad cluster
-
-		std::vector<glm::vec2> good_points;
-
-		glm::vec2 sum_points = { 0.f, 0.f };
-
-		//OutputDebugStringA("\n\n");
-
-		for(auto point : points) {
-			size_t closest = 0;
-			float best_dist = std::numeric_limits<float>::max();
-
-			//finding the closest centroid
-			for(size_t cluster = 0; cluster < num_of_clusters; cluster++) {
-				if(best_dist > glm::distance(centroids[cluster], point)) {
-					closest = cluster;
-					best_dist = glm::distance(centroids[cluster], point);
-				}
-			}
-
-
-			bool is_good = false;
-			for(size_t i = 0; i < good_centroids.size(); i++) {
-				if(closest == good_centroids[i])
-					is_good = true;
-			}
-
-			if (is_good) {
-				good_points.push_back(point);
-				sum_points += point;
-			}
-		}
-
-		points = good_points;
-		
-
-		//initial center:
-		glm::vec2 center = sum_points / (float)(points.size());
-
-		//calculate deviation
-		float total_sum = 0;
-
-		for(auto point : points) {
-			auto dif_v = point - center;
-			total_sum += dif_v.x * dif_v.x;
-		}
-
-		float mse = total_sum / points.size();
-		//ignore points beyond 3 std
-		float limit = mse * 3;
-
-		//calculate radius
-		//OutputDebugStringA("\n");
-		//OutputDebugStringA("\n");
-		float right = 0.f;
-		float left = 0.f;
-		float top = 0.f;
-		float bottom = 0.f;
-		for(auto point: points) {
-			//OutputDebugStringA((std::to_string(point.x) + ", " + std::to_string(point.y) + ", \n").c_str());
-			glm::vec2 current = point - center;
-			if((current.x > right) && (current.x * current.x < limit)) {
-				right = current.x;
-			}
-			if(current.y > top) {
-				top = current.y;
-			}
-			if((current.x < left) && (current.x * current.x < limit)) {
-				left = current.x;
-			}
-			if(current.y < bottom) {
-				bottom = current.y;
-			}
-		}
-
-		std::vector<glm::vec2> key_points;
-
-		key_points.push_back(center + glm::vec2(left, 0));
-		key_points.push_back(center + glm::vec2(0, bottom + local_step.y));
-		key_points.push_back(center + glm::vec2(right, 0));
-		key_points.push_back(center + glm::vec2(0, top - local_step.y));
-
-		std::array<glm::vec2, 5> key_provs{
-			center, //capital
-			center, //min x
-			center, //min y
-			center, //max x
-			center //max y
-		};
-
-		for(auto key_point : key_points) {
-			//if (glm::length(key_point - center) < 100.f * glm::length(eigenvector_1)) 
-			update_bbox(key_provs, key_point);
-		}
-
-
-		glm::vec2 map_size{ float(state.map_state.map_data.size_x), float(state.map_state.map_data.size_y) };
-		glm::vec2 basis{ key_provs[1].x, key_provs[2].y };
-		glm::vec2 ratio{ key_provs[3].x - key_provs[1].x, key_provs[4].y - key_provs[2].y };
-
-		if(ratio.x < 0.001f || ratio.y < 0.001f)
-			continue;
-
-		points = final_points;
-
-		//regularisation parameters
-		float lambda = 0.00001f;
-
-		float l_0 = 1.f;
-		float l_1 = 1.f;
-		float l_2 = 1 / 4.f;
-		float l_3 = 1 / 8.f;
-
-		// Populate common dataset points
-		std::vector<float> out_y;
-		std::vector<float> out_x;
-		std::vector<float> w;
-		std::vector<std::array<float, 4>> in_x;
-		std::vector<std::array<float, 4>> in_y;
-
-		for (auto point : points) {
-			auto e = point;
-
-			if(e.x < basis.x) {
-				continue;
-			}
-			if(e.x > basis.x + ratio.x) {
-				continue;
-			}
-
-			w.push_back(1);
-
-			e -= basis;
-			e /= ratio;
-			out_y.push_back(e.y);
-			out_x.push_back(e.x);
-			//w.push_back(10 * float(map_data.province_area[province::to_map_id(p2)]));
-					
-			in_x.push_back(std::array<float, 4>{ l_0 * 1.f, l_1* e.x, l_1* e.x* e.x, l_3* e.x* e.x* e.x});
-			in_y.push_back(std::array<float, 4>{ l_0 * 1.f, l_1* e.y, l_1* e.y* e.y, l_3* e.y* e.y* e.y});
-		}
-
 		auto prepared_name = text::stored_glyphs(state, text::font_selection::map_font, name);
 		float name_extent = f.text_extent(state, prepared_name, 0, uint32_t(prepared_name.glyph_info.size()), 1);
 
-		bool use_quadratic = false;
-		// We will try cubic regression first, if that results in very
-		// weird lines, for example, lines that go to the infinite
-		// we will "fallback" to using a quadratic instead
-		if(state.user_settings.map_label == sys::map_label_mode::cubic) {
-			// Columns -> n
-			// Rows -> fixed size of 4
-			// [ x0^0 x0^1 x0^2 x0^3 ]
-			// [ x1^0 x1^1 x1^2 x1^3 ]
-			// [ ...  ...  ...  ...  ]
-			// [ xn^0 xn^1 xn^2 xn^3 ]
-			// [AB]i,j = sum(n, r=1, a_(i,r) * b(r,j))
-			// [ x0^0 x0^1 x0^2 x0^3 ] * [ x0^0 x1^0 ... xn^0 ] = [ a0 a1 a2 ... an ]
-			// [ x1^0 x1^1 x1^2 x1^3 ] * [ x0^1 x1^1 ... xn^1 ] = [ b0 b1 b2 ... bn ]
-			// [ ...  ...  ...  ...  ] * [ x0^2 x1^2 ... xn^2 ] = [ c0 c1 c2 ... cn ]
-			// [ xn^0 xn^1 xn^2 xn^3 ] * [ x0^3 x1^3 ... xn^3 ] = [ d0 d1 d2 ... dn ]
-			glm::mat4x4 m0(0.f);
-			for(glm::length_t i = 0; i < m0.length(); i++)
-				for(glm::length_t j = 0; j < m0.length(); j++)
-					for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
-						m0[i][j] += in_x[r][j] * w[r] * in_x[r][i] / in_x.size();
-			for(glm::length_t i = 0; i < m0.length(); i++)
-				m0[i][i] += lambda;
-			m0 = glm::inverse(m0); // m0 = (T(X)*X/n + I*lambda)^-1
-			glm::vec4 m1(0.f); // m1 = T(X)*Y / n
-			for(glm::length_t i = 0; i < m1.length(); i++)
-				for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
-					m1[i] += in_x[r][i] * w[r] * out_y[r] / in_x.size();
-			glm::vec4 mo(0.f); // mo = m1 * m0
-			for(glm::length_t i = 0; i < mo.length(); i++)
-				for(glm::length_t j = 0; j < mo.length(); j++)
-					mo[i] += m0[i][j] * m1[j];
-			// y = a + bx + cx^2 + dx^3
-			// y = mo[0] + mo[1] * x + mo[2] * x * x + mo[3] * x * x * x
-			auto poly_fn = [&](float x) {
-				return mo[0] * l_0 + mo[1] * x * l_1 + mo[2] * x * x * l_2 + mo[3] * x * x * x * l_3;
-			};
-			auto dx_fn = [&](float x) {
-				return mo[1] * l_1 + 2.f * mo[2] * x * l_2 + 3.f * mo[3] * x * x * l_3;
-			};
-			auto error_grad = [&](float x, float y) {
-				float error_linear = poly_fn(x) - y;				
-				return glm::vec4(error_linear * error_linear * error_linear * error_linear * error_linear * mo);
-			};
-
-			auto regularisation_grad = [&]() {
-				return glm::vec4(0, 0, mo[2] / 4.f, mo[3] / 6.f);
-			};
-
-			float xstep = (1.f / float(name_extent * 2.f));
-			for(float x = 0.f; x <= 1.f; x += xstep) {
-				float y = poly_fn(x);
-				if(y < 0.f || y > 1.f) {
-					use_quadratic = true;
-					break;
-				}
-				// Steep change in curve => use cuadratic
-				float dx = glm::abs(dx_fn(x) - dx_fn(x - xstep));
-				if(dx / xstep >= 0.45f) {
-					use_quadratic = true;
-					break;
-				}
-			}			
-
-			if(!use_quadratic)
-				text_data.emplace_back(std::move(prepared_name), mo, basis, ratio);
-		}
-
-		bool use_linear = false;
-		if(state.user_settings.map_label == sys::map_label_mode::quadratic || use_quadratic) {
-			// Now lets try quadratic
-			glm::mat3x3 m0(0.f);
-			for(glm::length_t i = 0; i < m0.length(); i++)
-				for(glm::length_t j = 0; j < m0.length(); j++)
-					for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
-						m0[i][j] += in_x[r][j] * w[r] * in_x[r][i] / in_x.size();
-			for(glm::length_t i = 0; i < m0.length(); i++)
-				m0[i][i] += lambda;
-			m0 = glm::inverse(m0); // m0 = (T(X)*X)^-1
-			glm::vec3 m1(0.f); // m1 = T(X)*Y
-			for(glm::length_t i = 0; i < m1.length(); i++)
-				for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
-					m1[i] += in_x[r][i] * w[r] * out_y[r] / in_x.size();
-			glm::vec3 mo(0.f); // mo = m1 * m0
-			for(glm::length_t i = 0; i < mo.length(); i++)
-				for(glm::length_t j = 0; j < mo.length(); j++)
-					mo[i] += m0[i][j] * m1[j];
-			// y = a + bx + cx^2
-			// y = mo[0] + mo[1] * x + mo[2] * x * x
-			auto poly_fn = [&](float x) {
-				return mo[0] * l_0 + mo[1] * x * l_1 + mo[2] * x * x * l_2;
-			};
-			auto dx_fn = [&](float x) {
-				return mo[1] * l_1 + 2.f * mo[2] * x * l_2;
-			};
-			float xstep = (1.f / float(name_extent * 2.f));
-			for(float x = 0.f; x <= 1.f; x += xstep) {
-				float y = poly_fn(x);
-				if(y < 0.f || y > 1.f) {
-					use_linear = true;
-					break;
-				}
-				// Steep change in curve => use cuadratic
-				float dx = glm::abs(dx_fn(x) - dx_fn(x - xstep));
-				if(dx / xstep >= 0.45f) {
-					use_linear = true;
-					break;
-				}
+		labels.labelled.push_back(p);
+		labels.names.push_back(std::move(prepared_name));
+
+		auto& fit = labels.fits[p.id.index()];
+		if(fit.owner != n || fit.name != name || fit.name_extent != name_extent || fit.provinces != group_provinces) {
+			text_line_task task;
+			task.leader = p;
+			task.group = group;
+			task.fit.owner = n;
+			task.fit.name = name;
+			task.fit.name_extent = name_extent;
+			task.fit.provinces = group_provinces;
+			for(auto q : group_provinces) {
+				task.mid_points.push_back(state.world.province_get_mid_point(q));
+				labels.province_group[province::to_map_id(q)] = group;
 			}
-			if(!use_linear)
-				text_data.emplace_back(std::move(prepared_name), glm::vec4(mo, 0.f), basis, ratio);
-		}
-
-		if(state.user_settings.map_label == sys::map_label_mode::linear || use_linear) {
-			// Now lets try linear
-			glm::mat2x2 m0(0.f);
-			for(glm::length_t i = 0; i < m0.length(); i++)
-				for(glm::length_t j = 0; j < m0.length(); j++)
-					for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
-						m0[i][j] += in_x[r][j] * w[r] * in_x[r][i];
-			for(glm::length_t i = 0; i < m0.length(); i++)
-				m0[i][i] += lambda;
-			m0 = glm::inverse(m0); // m0 = (T(X)*X)^-1
-			glm::vec2 m1(0.f); // m1 = T(X)*Y
-			for(glm::length_t i = 0; i < m1.length(); i++)
-				for(glm::length_t r = 0; r < glm::length_t(in_x.size()); r++)
-					m1[i] += in_x[r][i] * w[r] * out_y[r];
-			glm::vec2 mo(0.f); // mo = m1 * m0
-			for(glm::length_t i = 0; i < mo.length(); i++)
-				for(glm::length_t j = 0; j < mo.length(); j++)
-					mo[i] += m0[i][j] * m1[j];
-
-			// y = a + bx
-			// y = mo[0] + mo[1] * x
-			auto poly_fn = [&](float x) {
-				return mo[0] * l_0 + mo[1] * x * l_1;
-			};
-
-
-			// check if this is really better than taking the longest horizontal
-
-			// firstly check if we are already horizontal
-			if(abs(mo[1]) > 0.05) {
-				// calculate where our line will start and end:
-				float left_side = 0.f;
-				float right_side = 1.f;
-
-				if(mo[1] > 0.01f) {
-					left_side = -mo[0] / mo[1];
-					right_side = (1.f - mo[0]) / mo[1];
-				} else if(mo[1] < -0.01f) {
-					left_side = (1.f - mo[0]) / mo[1];
-					right_side = -mo[0] / mo[1];
-				}
-
-				left_side = std::clamp(left_side, 0.f, 1.f);
-				right_side = std::clamp(right_side, 0.f, 1.f);
-
-				float length_in_box_units = glm::length(ratio * glm::vec2(poly_fn(left_side), poly_fn(right_side)));
+			labels.tasks.push_back(std::move(task));
+		}
+		++group;
+	}
 
-				if(best_y_length_real * 1.05f >= length_in_box_units) {
-					basis.x = best_y_left_x;
-					ratio.x = best_y_length_real;
-					mo[0] = (best_y - basis.y) / ratio.y;
-					mo[1] = 0;
-				}
+	if(labels.tasks.empty()) {
+		upload_text_lines(state, map_data);
+	} else {
+		labels.worker_done.store(false, std::memory_order::release);
+		labels.worker = std::thread([&labels, &map_data]() {
+			for(auto& task : labels.tasks) {
+				fit_text_line(map_data, labels.province_group, labels.mode, task);
 			}
-
-
-			if(ratio.x <= map_size.x * 0.75f && ratio.y <= map_size.y * 0.75f)
-				text_data.emplace_back(std::move(prepared_name), glm::vec4(mo, 0.f, 0.f), basis, ratio);
-		}
+			labels.worker_done.store(true, std::memory_order::release);
+		});
 	}
-	map_data.set_text_lines(state, text_data);
 
 	if(state.cheat_data.province_names) {
 		std::vector<text_line_generator_data> p_text_data;
@@ -1537,6 +1615,27 @@ void update_text_lines(sys::state& state, display_data& map_data) {
 	}
 }
 
+void collect_text_lines(sys::state& state, display_data& map_data) {
+	auto& labels = state.map_state.text_lines;
+	if(!labels.worker.joinable() || !labels.worker_done.load(std::memory_order::acquire))
+		return;
+
+	labels.worker.join();
+	if(state.user_settings.map_label != sys::map_label_mode::none) {
+		upload_text_lines(state, map_data);
+	} else {
+		// the labels were turned off while this batch was being fitted
+		store_text_line_fits(state);
+		labels.labelled.clear();
+		labels.names.clear();
+	}
+	if(labels.update_queued) {
+		labels.update_queued = false;
+		if(state.user_settings.map_label != sys::map_label_mode::none)
+			update_text_lines(state, map_data);
+	}
+}
+
 void map_state::update(sys::state& state) {
 	std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
 	// Set the last_update_time if it hasn't been set yet
@@ -1702,6 +1801,8 @@ void map_state::update(sys::state& state) {
 void map_state::set_province_color(std::vector<uint32_t> const& prov_color, map_mode::mode new_map_mode) {
 	if (new_map_mode != map_mode::mode::handled_from_outside)
 		active_map_mode = new_map_mode;
+	else
+		map_modes.target = map_mode::mode::handled_from_outside; // a map mode still being computed must not overwrite these colors
 	map_data.set_province_color(prov_color);
 }
 
@@ -4,6 +4,10 @@
 #include <glm/vec2.hpp>
 #include <glm/mat4x4.hpp>
 #include "map.hpp"
+#include "constants.hpp"
+#include <array>
+#include <atomic>
+#include <thread>
 
 namespace sys {
 struct state;
@@ -15,6 +19,78 @@ struct scenario_building_context;
 namespace map {
 
 enum class map_view { globe, globe_perspect, flat };
+
+// the curve fitted to the label of one group of connected regions
+struct text_line_fit {
+	dcon::nation_id owner;
+	std::string name;
+	float name_extent = 0.f;
+	std::vector<dcon::province_id> provinces;
+	bool has_line = false;
+	glm::vec4 coeff{ 0.f };
+	glm::vec2 basis{ 0.f };
+	glm::vec2 ratio{ 0.f };
+};
+
+struct text_line_task {
+	dcon::province_id leader;
+	int32_t group = 0;
+	std::vector<glm::vec2> mid_points;
+	text_line_fit fit;
+};
+
+// map labels are only refitted for groups whose provinces, owner or name changed, and the fitting runs on a worker thread
+struct text_line_cache {
+	std::vector<text_line_fit> fits; // indexed by the first province of each labelled group
+	sys::map_label_mode mode = sys::map_label_mode::none;
+
+	std::thread worker;
+	std::atomic<bool> worker_done = false;
+	bool update_queued = false;
+	std::vector<text_line_task> tasks;
+	std::vector<int32_t> province_group; // map id -> group being fitted, -1 otherwise
+	std::vector<dcon::province_id> labelled;
+	std::vector<text::stored_glyphs> names;
+
+	~text_line_cache() {
+		if(worker.joinable())
+			worker.join();
+	}
+};
+// the ui state a map mode reads, taken on the render thread when its colors are requested
+struct map_mode_inputs {
+	dcon::province_id selection;
+	dcon::nation_id player;
+};
+
+// the colors of one map mode together with the inputs they were computed from
+struct map_mode_colors {
+	std::vector<uint32_t> colors;
+	dcon::province_id selection;
+	dcon::nation_id player;
+	uint32_t generation = 0;
+	sys::map_vassal_color_mode vassal_color = sys::map_vassal_color_mode::inherit;
+	sys::color_blind_mode color_blind = sys::color_blind_mode::none;
+	bool valid = false;
+};
+
+// map mode colors are kept until one of their inputs changes; they are rebuilt on a worker thread into a back buffer that is swapped in once complete
+struct map_mode_cache {
+	std::array<map_mode_colors, 256> modes; // indexed by map mode
+	uint32_t generation = 0; // bumped for every game state update seen by the render thread
+	map_mode::mode target = map_mode::mode::terrain; // the mode whose colors should be shown
+
+	std::thread worker;
+	std::atomic<bool> worker_done = false;
+	bool update_queued = false;
+	map_mode::mode back_mode = map_mode::mode::terrain;
+	map_mode_colors back; // only touched by the worker while it runs
+
+	~map_mode_cache() {
+		if(worker.joinable())
+			worker.join();
+	}
+};
 class map_state {
 public:
 	map_state(){};
@@ -58,6 +134,8 @@ public:
 	dcon::province_id selected_province = dcon::province_id{};
 
 	display_data map_data;
+	text_line_cache text_lines;
+	map_mode_cache map_modes;
 	bool is_dragging = false;
 
 	// Last update time, used for smooth map movement
@@ -105,5 +183,6 @@ public:
 };
 
 void update_text_lines(sys::state& state, display_data& map_data);
+void collect_text_lines(sys::state& state, display_data& map_data);
 
 } // namespace map
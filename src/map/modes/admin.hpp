@@ -1,11 +1,11 @@
 #pragma once
 
-std::vector<uint32_t> admin_map_from(sys::state& state) {
+std::vector<uint32_t> admin_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	dcon::province_id selected_province = state.map_state.get_selected_province();
+	dcon::province_id selected_province = in.selection;
 	dcon::nation_id selected_nation = selected_province
 		? state.world.province_get_nation_from_province_ownership(selected_province)
 		: dcon::nation_id{};
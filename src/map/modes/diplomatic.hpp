@@ -1,6 +1,6 @@
 #pragma once
 
-std::vector<uint32_t> get_selected_diplomatic_color(sys::state& state) {
+std::vector<uint32_t> get_selected_diplomatic_color(sys::state& state, map::map_mode_inputs const& in) {
 	/**
 	 * Color:
 	 *	- Yellorange -> Casus belli TODO: How do I get the casus belli?
@@ -28,11 +28,11 @@ std::vector<uint32_t> get_selected_diplomatic_color(sys::state& state) {
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
 
-	auto fat_selected_id = dcon::fatten(state.world, state.map_state.get_selected_province());
+	auto fat_selected_id = dcon::fatten(state.world, in.selection);
 	auto selected_nation = fat_selected_id.get_nation_from_province_ownership();
 
 	if(!bool(selected_nation)) {
-		selected_nation = state.local_player_nation;
+		selected_nation = in.player;
 	}
 
 	std::vector<dcon::nation_id> enemies, allies, sphere;
@@ -128,13 +128,13 @@ std::vector<uint32_t> get_selected_diplomatic_color(sys::state& state) {
 	return prov_color;
 }
 
-std::vector<uint32_t> diplomatic_map_from(sys::state& state) {
+std::vector<uint32_t> diplomatic_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	std::vector<uint32_t> prov_color;
 
-	if(state.map_state.get_selected_province()) {
-		prov_color = get_selected_diplomatic_color(state);
+	if(in.selection) {
+		prov_color = get_selected_diplomatic_color(state, in);
 	} else {
-		prov_color = get_selected_diplomatic_color(state);
+		prov_color = get_selected_diplomatic_color(state, in);
 	}
 
 	return prov_color;
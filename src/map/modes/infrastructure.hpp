@@ -1,6 +1,6 @@
 #pragma once
 
-std::vector<uint32_t> infrastructure_map_from(sys::state& state) {
+std::vector<uint32_t> infrastructure_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 
@@ -11,17 +11,17 @@ std::vector<uint32_t> infrastructure_map_from(sys::state& state) {
 		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
 
 		int32_t current_rails_lvl = state.world.province_get_building_level(prov_id, uint8_t(economy::province_building_type::railroad));
-		int32_t max_local_rails_lvl = state.world.nation_get_max_building_level(state.local_player_nation, uint8_t(economy::province_building_type::railroad));
+		int32_t max_local_rails_lvl = state.world.nation_get_max_building_level(in.player, uint8_t(economy::province_building_type::railroad));
 		bool party_allows_building_railroads =
-				(nation == state.local_player_nation &&
+				(nation == in.player &&
 						(state.world.nation_get_combined_issue_rules(nation) & issue_rule::build_railway) != 0) ||
-				(nation != state.local_player_nation &&
+				(nation != in.player &&
 						(state.world.nation_get_combined_issue_rules(nation) & issue_rule::allow_foreign_investment) != 0);
 		uint32_t color;
 
 		if(party_allows_building_railroads) {
 
-			if(province::can_build_railroads(state, prov_id, state.local_player_nation)) {
+			if(province::can_build_railroads(state, prov_id, in.player)) {
 
 				color = ogl::color_gradient(float(current_rails_lvl) / float(max_rails_lvl), sys::pack_color(14, 240, 44), // green
 						sys::pack_color(41, 5, 245)																																						 // blue
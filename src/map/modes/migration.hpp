@@ -1,12 +1,12 @@
 #pragma once
 
-std::vector<uint32_t> migration_map_from(sys::state& state) {
+std::vector<uint32_t> migration_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 
 	std::vector<uint32_t> prov_color(texture_size * 2);
 
-	auto selected = state.map_state.selected_province;
+	auto selected = in.selection;
 	auto for_nation = state.world.province_get_nation_from_province_ownership(selected);
 	if(for_nation) {
 		float mx = 0.0f;
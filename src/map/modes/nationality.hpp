@@ -50,8 +50,8 @@ std::vector<uint32_t> get_nationality_global_color(sys::state& state) {
 	return prov_color;
 }
 
-std::vector<uint32_t> get_nationality_diaspora_color(sys::state& state) {
-	auto fat_selected_id = dcon::fatten(state.world, state.map_state.get_selected_province());
+std::vector<uint32_t> get_nationality_diaspora_color(sys::state& state, map::map_mode_inputs const& in) {
+	auto fat_selected_id = dcon::fatten(state.world, in.selection);
 	auto culture_id = fat_selected_id.get_dominant_culture();
 	auto culture_key = demographics::to_key(state, culture_id.id);
 
@@ -85,10 +85,10 @@ std::vector<uint32_t> get_nationality_diaspora_color(sys::state& state) {
 	return prov_color;
 }
 
-std::vector<uint32_t> nationality_map_from(sys::state& state) {
+std::vector<uint32_t> nationality_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	std::vector<uint32_t> prov_color;
-	if(state.map_state.get_selected_province()) {
-		prov_color = get_nationality_diaspora_color(state);
+	if(in.selection) {
+		prov_color = get_nationality_diaspora_color(state, in);
 	} else {
 		prov_color = get_nationality_global_color(state);
 	}
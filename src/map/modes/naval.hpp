@@ -2,7 +2,7 @@
 
 #include <vector>
 
-std::vector<uint32_t> naval_map_from(sys::state& state) {
+std::vector<uint32_t> naval_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 
@@ -12,14 +12,14 @@ std::vector<uint32_t> naval_map_from(sys::state& state) {
 		auto fat_id = dcon::fatten(state.world, prov_id);
 		auto nation = fat_id.get_nation_from_province_ownership();
 
-		if(nation == state.local_player_nation) {
+		if(nation == in.player) {
 			uint32_t color = 0x222222;
 			uint32_t stripe_color = 0x222222;
 
 			if(province::has_naval_base_being_built(state, prov_id)) {
 				color = 0x00FF00;
 				stripe_color = 0x005500;
-			} else if(province::can_build_naval_base(state, prov_id, state.local_player_nation)) {
+			} else if(province::can_build_naval_base(state, prov_id, in.player)) {
 				if(state.world.province_get_building_level(prov_id, uint8_t(economy::province_building_type::naval_base)) != 0) {
 					color = 0x00FF00;
 					stripe_color = 0x00FF00;
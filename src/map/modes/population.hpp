@@ -32,8 +32,8 @@ std::vector<uint32_t> get_global_population_color(sys::state& state) {
 	return prov_color;
 }
 
-std::vector<uint32_t> get_national_population_color(sys::state& state) {
-	auto fat_selected_id = dcon::fatten(state.world, state.map_state.get_selected_province());
+std::vector<uint32_t> get_national_population_color(sys::state& state, map::map_mode_inputs const& in) {
+	auto fat_selected_id = dcon::fatten(state.world, in.selection);
 	auto nat_id = fat_selected_id.get_nation_from_province_ownership();
 	if(!bool(nat_id)) {
 		return get_global_population_color(state);
@@ -71,10 +71,10 @@ std::vector<uint32_t> get_national_population_color(sys::state& state) {
 	return prov_color;
 }
 
-std::vector<uint32_t> population_map_from(sys::state& state) {
+std::vector<uint32_t> population_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	std::vector<uint32_t> prov_color;
-	if(state.map_state.get_selected_province()) {
-		prov_color = get_national_population_color(state);
+	if(in.selection) {
+		prov_color = get_national_population_color(state, in);
 	} else {
 		prov_color = get_global_population_color(state);
 	}
@@ -1,6 +1,6 @@
 #pragma once
 
-std::vector<uint32_t> recruitment_map_from(sys::state& state) {
+std::vector<uint32_t> recruitment_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 
@@ -10,7 +10,7 @@ std::vector<uint32_t> recruitment_map_from(sys::state& state) {
 		auto fat_id = dcon::fatten(state.world, prov_id);
 		auto nation = fat_id.get_nation_from_province_ownership();
 
-		if(nation == state.local_player_nation) {
+		if(nation == in.player) {
 			auto max_regiments = military::regiments_max_possible_from_province(state, prov_id);
 			auto created_regiments = military::regiments_created_from_province(state, prov_id);
 
@@ -1,17 +1,17 @@
 #pragma once
 
-std::vector<uint32_t> relation_map_from(sys::state& state) {
+std::vector<uint32_t> relation_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 
 	std::vector<uint32_t> prov_color(texture_size * 2);
 
-	auto selected_province = state.map_state.get_selected_province();
+	auto selected_province = in.selection;
 	auto fat_id = dcon::fatten(state.world, selected_province);
 	auto selected_nation = fat_id.get_nation_from_province_ownership();
 
 	if(!selected_nation) {
-		selected_nation = state.local_player_nation;
+		selected_nation = in.player;
 	}
 
 	auto relations = selected_nation.get_diplomatic_relation_as_related_nations();
@@ -50,8 +50,8 @@ std::vector<uint32_t> get_religion_global_color(sys::state& state) {
 	return prov_color;
 }
 
-std::vector<uint32_t> get_religion_diaspora_color(sys::state& state) {
-	auto fat_selected_id = dcon::fatten(state.world, state.map_state.get_selected_province());
+std::vector<uint32_t> get_religion_diaspora_color(sys::state& state, map::map_mode_inputs const& in) {
+	auto fat_selected_id = dcon::fatten(state.world, in.selection);
 	auto religion_id = fat_selected_id.get_dominant_religion();
 	auto religion_key = demographics::to_key(state, religion_id.id);
 
@@ -81,10 +81,10 @@ std::vector<uint32_t> get_religion_diaspora_color(sys::state& state) {
 	return prov_color;
 }
 
-std::vector<uint32_t> religion_map_from(sys::state& state) {
+std::vector<uint32_t> religion_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	std::vector<uint32_t> prov_color;
-	if(state.map_state.get_selected_province()) {
-		prov_color = get_religion_diaspora_color(state);
+	if(in.selection) {
+		prov_color = get_religion_diaspora_color(state, in);
 	} else {
 		prov_color = get_religion_global_color(state);
 	}
@@ -1,11 +1,11 @@
 #pragma once
 
 
-std::vector<uint32_t> revolt_map_from(sys::state& state) {
+std::vector<uint32_t> revolt_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	auto sel_nation = state.world.province_get_nation_from_province_ownership(in.selection);
 	std::unordered_map<uint16_t, float> rebels_in_province = {};
 	std::unordered_map<int32_t, float> continent_max_rebels = {};
 	state.world.for_each_rebel_faction([&](dcon::rebel_faction_id id) {
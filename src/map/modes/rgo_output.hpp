@@ -1,11 +1,11 @@
 #pragma once
-std::vector<uint32_t> rgo_output_map_from(sys::state& state) {
+std::vector<uint32_t> rgo_output_map_from(sys::state& state, map::map_mode_inputs const& in) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 
 	std::vector<uint32_t> prov_color(texture_size * 2);
 
-	auto selected_province = state.map_state.get_selected_province();
+	auto selected_province = in.selection;
 	if(selected_province) {
 		auto searched_rgo = state.world.province_get_rgo(selected_province);
 		float max_rgo_size = 0.f;
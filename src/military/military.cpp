@@ -6854,17 +6854,22 @@ void update_land_battles(sys::state& state) {
 	auto isize = state.world.land_battle_size();
 	auto to_delete = ve::vectorizable_buffer<uint8_t, dcon::land_battle_id>(isize);
 
+	// the message queue has a single producer, so notifications are posted before the parallel section
+	for(uint32_t i = 0; i < isize; ++i) {
+		dcon::land_battle_id b{ dcon::land_battle_id::value_base_t(i) };
+		if(state.world.land_battle_is_valid(b) && state.world.land_battle_get_start_date(b) == state.current_date) {
+			notify_on_new_land_battle(state, b, state.local_player_nation);
+		}
+	}
+
+	// each battle only touches its own regiments and reserves here
+	// anything affecting other battles or nations (prestige, war score, deleting units) happens in end_battle below
 	concurrency::parallel_for(0, int32_t(isize), [&](int32_t index) {
 		dcon::land_battle_id b{ dcon::land_battle_id::value_base_t(index) };
 
 		if(!state.world.land_battle_is_valid(b))
 			return;
 
-
-		if(state.world.land_battle_get_start_date(b) == state.current_date) {
-			notify_on_new_land_battle(state, b, state.local_player_nation);
-		}
-
 		// fill to combat width
 		auto combat_width = state.world.land_battle_get_combat_width(b);
 
@@ -7814,9 +7819,25 @@ A navy is also stackwiped if there is no accessible ports for the retreat to pat
 
 
 
+// objects removed by a naval battle while it is being updated in parallel
+// creating and deleting dcon objects is not thread safe, so the deletions are applied afterwards in battle order
+struct naval_battle_removals {
+	std::vector<dcon::ship_id> sunk_ships;
+	std::vector<dcon::navy_battle_participation_id> retreated_navies;
+};
+
 void update_naval_battles(sys::state& state) {
 	auto isize = state.world.naval_battle_size();
 	auto to_delete = ve::vectorizable_buffer<uint8_t, dcon::naval_battle_id>(isize);
+	std::vector<naval_battle_removals> removals(isize);
+
+	// notify if needed about new battles; the message queue has a single producer
+	for(uint32_t i = 0; i < isize; ++i) {
+		dcon::naval_battle_id b{ dcon::naval_battle_id::value_base_t(i) };
+		if(state.world.naval_battle_is_valid(b) && state.world.naval_battle_get_start_date(b) == state.current_date) {
+			notify_on_new_naval_battle(state, b, state.local_player_nation);
+		}
+	}
 
 	concurrency::parallel_for(0, int32_t(isize), [&](int32_t index) {
 		dcon::naval_battle_id b{ dcon::naval_battle_id::value_base_t(index) };
@@ -7825,13 +7846,9 @@ void update_naval_battles(sys::state& state) {
 			return;
 
 		auto slots = state.world.naval_battle_get_slots(b);
+		auto& removed = removals[index];
 
-		
 		if(state.world.naval_battle_get_start_date(b) == state.current_date) {
-			// notify if needed about new battle
-			notify_on_new_naval_battle(state, b, state.local_player_nation);
-
-
 			// compare total hull of new battles to see if it's an instant wipe
 			float attacker_hull = 0;
 			float defender_hull = 0;
@@ -7875,7 +7892,7 @@ void update_naval_battles(sys::state& state) {
 								assert(false);
 						}
 						state.world.naval_battle_set_defender_loss_value(b, state.world.naval_battle_get_defender_loss_value(b) + state.military_definitions.unit_base_definitions[unit_type].supply_consumption_score);
-						state.world.delete_ship(slots[j].ship);
+						removed.sunk_ships.push_back(slots[j].ship);
 						slots[j].flags &= ~ship_in_battle::mode_mask;
 						slots[j].flags |= ship_in_battle::mode_sunk;
 						slots[j].ship = dcon::ship_id{ };
@@ -7912,7 +7929,7 @@ void update_naval_battles(sys::state& state) {
 								assert(false);
 						}
 						state.world.naval_battle_set_attacker_loss_value(b, state.world.naval_battle_get_attacker_loss_value(b) + state.military_definitions.unit_base_definitions[unit_type].supply_consumption_score);
-						state.world.delete_ship(slots[j].ship);
+						removed.sunk_ships.push_back(slots[j].ship);
 						slots[j].flags &= ~ship_in_battle::mode_mask;
 						slots[j].flags |= ship_in_battle::mode_sunk;
 						slots[j].ship = dcon::ship_id{ };
@@ -8182,7 +8199,7 @@ void update_naval_battles(sys::state& state) {
 						battle_ship->ship = dcon::ship_id{ };
 
 					}
-					state.world.delete_navy_battle_participation(*iterator);
+					removed.retreated_navies.push_back((*iterator).id);
 				}
 
 			}
@@ -8192,6 +8209,12 @@ void update_naval_battles(sys::state& state) {
 		}
 	});
 
+	for(uint32_t i = 0; i < isize; ++i) {
+		for(auto s : removals[i].sunk_ships)
+			state.world.delete_ship(s);
+		for(auto p : removals[i].retreated_navies)
+			state.world.delete_navy_battle_participation(p);
+	}
 
 	for(auto i = isize; i-- > 0;) {
 		dcon::naval_battle_id b{ dcon::naval_battle_id::value_base_t(i) };
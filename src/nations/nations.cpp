@@ -168,6 +168,75 @@ void restore_unsaved_values(sys::state& state) {
 	restore_cached_values(state);
 }
 
+// effective distances along sea lanes from the port of the coastal province start to the ports of targets,
+// measured the same way as trade route distances; infinity for targets which can't be reached by sea
+std::vector<float> effective_sea_distances(sys::state& state, dcon::province_id start, std::vector<dcon::province_id> const& targets) {
+	constexpr float unreachable = std::numeric_limits<float>::infinity();
+	std::vector<float> result(targets.size(), unreachable);
+
+	auto start_port = state.world.province_get_port_to(start);
+	if(!start_port)
+		return result;
+
+	auto cost = [&](dcon::province_id a, dcon::province_id b, dcon::province_adjacency_id adj) {
+		float sum_mods =
+			state.world.province_get_modifier_values(a, sys::provincial_mod_offsets::movement_cost)
+			+ state.world.province_get_modifier_values(b, sys::provincial_mod_offsets::movement_cost);
+		return std::max(0.01f, province::distance(state, adj) * std::max(0.01f, (sum_mods * 2.f + 1.0f)));
+	};
+
+	std::vector<float> distance(state.world.province_size(), unreachable);
+	std::vector<uint8_t> is_target_port(state.world.province_size(), 0);
+	int32_t pending_ports = 0;
+	for(auto t : targets) {
+		auto port = state.world.province_get_port_to(t);
+		if(port && !is_target_port[port.index()]) {
+			is_target_port[port.index()] = 1;
+			++pending_ports;
+		}
+	}
+
+	// dijkstra over sea provinces, stopped as soon as every port of interest is settled
+	std::vector<std::pair<float, int32_t>> heap;
+	distance[start_port.index()] = cost(start, start_port, state.world.get_province_adjacency_by_province_pair(start, start_port));
+	heap.push_back({ distance[start_port.index()], start_port.index() });
+	while(!heap.empty() && pending_ports > 0) {
+		std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+		auto [d, index] = heap.back();
+		heap.pop_back();
+		if(d > distance[index])
+			continue;
+		if(is_target_port[index]) {
+			is_target_port[index] = 0;
+			--pending_ports;
+		}
+
+		dcon::province_id current{ dcon::province_id::value_base_t(index) };
+		for(auto adj : state.world.province_get_province_adjacency(current)) {
+			// can't move over impassible connections; can't leave the sea except in the target port
+			if((adj.get_type() & (province::border::impassible_bit | province::border::coastal_bit)) != 0)
+				continue;
+			auto other = adj.get_connected_provinces(0) == current ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+			if(other.id.index() < state.province_definitions.first_sea_province.index())
+				continue;
+			auto candidate = d + cost(current, other, adj);
+			if(candidate < distance[other.id.index()]) {
+				distance[other.id.index()] = candidate;
+				heap.push_back({ candidate, other.id.index() });
+				std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+			}
+		}
+	}
+
+	for(size_t i = 0; i < targets.size(); i++) {
+		auto port = state.world.province_get_port_to(targets[i]);
+		if(port && distance[port.index()] < unreachable) {
+			result[i] = distance[port.index()] + cost(port, targets[i], state.world.get_province_adjacency_by_province_pair(port, targets[i]));
+		}
+	}
+	return result;
+}
+
 void recalculate_markets_distance(sys::state& state) {
 	state.world.execute_parallel_over_market([&](auto markets) {
 		auto sids = state.world.market_get_zone_from_local_market(markets);
@@ -190,63 +259,61 @@ void recalculate_markets_distance(sys::state& state) {
 		state.world.market_set_max_throughput(markets, throughput);
 	});
 
-	state.world.execute_parallel_over_trade_route([&](auto routes) {
-		// recalculate effective distance
-		auto markets_0 = ve::apply([&](auto route) { return state.world.trade_route_get_connected_markets(route, 0); }, routes);
-		auto markets_1 = ve::apply([&](auto route) { return state.world.trade_route_get_connected_markets(route, 1); }, routes);
-
-		auto sids_0 = state.world.market_get_zone_from_local_market(markets_0);
-		auto sids_1 = state.world.market_get_zone_from_local_market(markets_1);
+	// sea routes: one pass over sea lanes for every market which is the origin of some sea routes
+	concurrency::parallel_for(uint32_t(0), state.world.market_size(), [&](uint32_t i) {
+		dcon::market_id market{ dcon::market_id::value_base_t(i) };
+		if(!state.world.market_is_valid(market))
+			return;
 
-		ve::apply([&](auto sid_0, auto sid_1, auto route) {
-			if (state.world.trade_route_get_is_sea_route(route)) {
-				std::vector<dcon::province_id> path{ };
-				dcon::province_id p_prev{ };
+		std::vector<dcon::trade_route_id> routes;
+		std::vector<dcon::province_id> targets;
+		for(auto route : state.world.market_get_trade_route(market)) {
+			if(state.world.trade_route_get_connected_markets(route, 0) != market)
+				continue;
+			if(!state.world.trade_route_get_is_sea_route(route)) {
+				state.world.trade_route_set_sea_distance(route, 99999.f);
+				continue;
+			}
+			auto target = state.world.trade_route_get_connected_markets(route, 1);
+			routes.push_back(route);
+			targets.push_back(province::state_get_coastal_capital(state, state.world.market_get_zone_from_local_market(target)));
+		}
+		if(routes.empty())
+			return;
 
-				auto coast_0 = province::state_get_coastal_capital(state, sid_0);
-				auto coast_1 = province::state_get_coastal_capital(state, sid_1);
-				auto owner_0 = state.world.province_get_nation_from_province_ownership(coast_0);
-				auto owner_1 = state.world.province_get_nation_from_province_ownership( coast_1);
-				auto transport_0 = military::get_best_transport(state, owner_0, false, false);
-				auto transport_1 = military::get_best_transport(state, owner_1, false, false);
-				auto stats_0 = state.world.nation_get_unit_stats(owner_0, transport_0);
-				auto stats_1 = state.world.nation_get_unit_stats(owner_1, transport_1);
+		auto coast_0 = province::state_get_coastal_capital(state, state.world.market_get_zone_from_local_market(market));
+		auto owner_0 = state.world.province_get_nation_from_province_ownership(coast_0);
+		auto transport_0 = military::get_best_transport(state, owner_0, false, false);
+		auto stats_0 = state.world.nation_get_unit_stats(owner_0, transport_0);
 
-				auto speed = std::max(1.f, std::max(stats_0.maximum_speed, stats_1.maximum_speed));
+		auto distances = effective_sea_distances(state, coast_0, targets);
 
-				path = province::make_unowned_naval_path(state, coast_0, coast_1);
-				p_prev = coast_0;
+		for(size_t j = 0; j < routes.size(); j++) {
+			auto owner_1 = state.world.province_get_nation_from_province_ownership(targets[j]);
+			auto transport_1 = military::get_best_transport(state, owner_1, false, false);
+			auto stats_1 = state.world.nation_get_unit_stats(owner_1, transport_1);
 
-				auto ps = path.size();
-				auto effective_distance = 0.f;
-				auto worst_movement_cost = 0.f;
-
-				for(size_t i = 0; i < ps; i++) {
-					auto p_current = path[i];
-					auto adj = state.world.get_province_adjacency_by_province_pair(p_prev, p_current);
-					float distance = province::distance(state, adj);
-					float sum_mods =
-						state.world.province_get_modifier_values(p_current, sys::provincial_mod_offsets::movement_cost)
-						+ state.world.province_get_modifier_values(p_prev, sys::provincial_mod_offsets::movement_cost);
-					effective_distance += std::max(0.01f, distance * std::max(0.01f, (sum_mods * 2.f + 1.0f)));
-					if(sum_mods > worst_movement_cost)
-						worst_movement_cost = std::max(0.01f, sum_mods);
-
-					p_prev = p_current;
-				}
-
-				if(effective_distance == 0.f) {
-					// no path, remove sea connection
-					state.world.trade_route_set_sea_distance(route, 99999.f);
-				} else {
-					assert(speed > 0.f);
-					state.world.trade_route_set_sea_distance(route, effective_distance / speed);
-				}
+			auto speed = std::max(1.f, std::max(stats_0.maximum_speed, stats_1.maximum_speed));
 
+			if(!std::isfinite(distances[j])) {
+				// no path, remove sea connection
+				state.world.trade_route_set_sea_distance(routes[j], 99999.f);
 			} else {
-				state.world.trade_route_set_sea_distance(route, 99999.f);
+				assert(speed > 0.f);
+				state.world.trade_route_set_sea_distance(routes[j], distances[j] / speed);
 			}
+		}
+	});
 
+	state.world.execute_parallel_over_trade_route([&](auto routes) {
+		// recalculate effective distance
+		auto markets_0 = ve::apply([&](auto route) { return state.world.trade_route_get_connected_markets(route, 0); }, routes);
+		auto markets_1 = ve::apply([&](auto route) { return state.world.trade_route_get_connected_markets(route, 1); }, routes);
+
+		auto sids_0 = state.world.market_get_zone_from_local_market(markets_0);
+		auto sids_1 = state.world.market_get_zone_from_local_market(markets_1);
+
+		ve::apply([&](auto sid_0, auto sid_1, auto route) {
 			if(state.world.trade_route_get_is_land_route(route)) {
 				std::vector<dcon::province_id> path{ };
 				dcon::province_id p_prev{ };
@@ -327,260 +394,217 @@ void generate_sea_trade_routes(sys::state& state) {
 
 	auto base_speed = total_transport_speed / total_amount_of_transports;
 
-	// buffer for "capitals" of connected regions:
-	std::array<dcon::state_instance_id, 4000> capital_of_region = {};
-	std::array<float, 10000> population_of_region = { };
-	std::vector<float> nation_to_max_population = { };
-	nation_to_max_population.resize(state.world.nation_size());
-
-	state.world.for_each_state_instance([&](auto candidate) {
-		// auto capital = state.world.state_instance_get_capital(candidate);
-		auto capital = province::state_get_coastal_capital(state, candidate);
-		if(capital) {
-			auto connected_region = state.world.province_get_connected_coast_id(capital);
-			auto size = state.world.state_instance_get_demographics(
-				candidate, demographics::total
-			);
-
-			population_of_region[connected_region] += size;
-
-			if(!capital_of_region[connected_region]) {
-				capital_of_region[connected_region] = candidate;
-			} else {
-				auto current_population = state.world.state_instance_get_demographics(
-					capital_of_region[connected_region], demographics::total
-				);
-				if(size > current_population) {
-					capital_of_region[connected_region] = candidate;
-				}
-			}
-		}		
+	struct coastal_state {
+		dcon::state_instance_id sid;
+		dcon::market_id market;
+		dcon::province_id coast;
+		dcon::province_id capital;
+		dcon::nation_id owner;
+		dcon::state_instance_id owner_capital_state;
+		uint16_t connected_region = 0;
+		float population = 0.f;
+		uint32_t naval_base = 0;
+	};
+
+	std::vector<coastal_state> coastal_states;
+	state.world.for_each_state_instance([&](auto sid) {
+		auto coast = province::state_get_coastal_capital(state, sid);
+		if(!coast)
+			return;
+		auto owner = state.world.state_instance_get_nation_from_state_ownership(sid);
+		coastal_states.push_back(coastal_state{
+			sid,
+			state.world.state_instance_get_market_from_local_market(sid),
+			coast,
+			state.world.state_instance_get_capital(sid),
+			owner,
+			state.world.province_get_state_membership(state.world.nation_get_capital(owner)),
+			state.world.province_get_connected_coast_id(coast),
+			state.world.state_instance_get_demographics(sid, demographics::total),
+			military::state_naval_base_level(state, sid)
+		});
 	});
 
-	state.world.for_each_state_instance([&](auto candidate) {
-		auto capital = province::state_get_coastal_capital(state, candidate);
-		if(capital) {
-			auto connected_region = state.world.province_get_connected_coast_id(capital);
-			auto owner = state.world.province_get_nation_from_province_ownership(capital);
-			auto size = population_of_region[connected_region];
-			nation_to_max_population[owner.index()] = std::max(nation_to_max_population[owner.index()], size);
-		}
+	// buffers for "capitals" of connected regions:
+	uint16_t max_region = 0;
+	state.world.for_each_province([&](auto p) {
+		max_region = std::max(max_region, state.world.province_get_connected_coast_id(p));
 	});
+	std::vector<dcon::state_instance_id> capital_of_region(size_t(max_region) + 1);
+	std::vector<float> population_of_region(size_t(max_region) + 1, 0.f);
+	std::vector<float> nation_to_max_population(state.world.nation_size(), 0.f);
 
-	// baseline: connection between new york and london
+	for(auto& c : coastal_states) {
+		population_of_region[c.connected_region] += c.population;
 
-	constexpr float M = 0.17f * 0.000'000'1f;
+		if(!capital_of_region[c.connected_region]) {
+			capital_of_region[c.connected_region] = c.sid;
+		} else {
+			auto current_population = state.world.state_instance_get_demographics(
+				capital_of_region[c.connected_region], demographics::total
+			);
+			if(c.population > current_population) {
+				capital_of_region[c.connected_region] = c.sid;
+			}
+		}
+	}
 
-	float world_population = 0.f;
-	state.world.for_each_nation([&](auto nation) {
-		world_population += state.world.nation_get_demographics(nation, demographics::total);
-	});
+	for(auto& c : coastal_states) {
+		auto owner = state.world.province_get_nation_from_province_ownership(c.coast);
+		nation_to_max_population[owner.index()] = std::max(nation_to_max_population[owner.index()], population_of_region[c.connected_region]);
+	}
 
-	state.world.for_each_state_instance([&](auto origin) {
-		if(!province::state_is_coastal(state, origin))
-			return;
+	// baseline: connection between new york and london
 
-		auto market = state.world.state_instance_get_market_from_local_market(origin);
+	constexpr float M = 0.17f * 0.000'000'1f;
 
-		auto capital = state.world.state_instance_get_capital(origin);
-		auto owner = state.world.state_instance_get_nation_from_state_ownership(origin);
-		auto state_owner_capital = state.world.nation_get_capital(owner);
-		auto state_owner_capital_state = state.world.province_get_state_membership(state_owner_capital);
+	// decide about every ordered pair of coastal states in parallel,
+	// then create routes serially in the same order the pairs were considered
+	std::vector<std::vector<uint32_t>> existing_routes(coastal_states.size());
+	std::vector<std::vector<uint32_t>> new_routes(coastal_states.size());
 
-		auto naval_base_origin = military::state_naval_base_level(state, origin);
-		auto population_origin = state.world.state_instance_get_demographics(origin, demographics::total);
-		auto coast_0 = province::state_get_coastal_capital(state, origin);
-		auto connected_region = state.world.province_get_connected_coast_id(coast_0);
-		auto connected_region_size = 0.f;
+	concurrency::parallel_for(uint32_t(0), uint32_t(coastal_states.size()), [&](uint32_t i) {
+		auto& origin = coastal_states[i];
 
-		state.world.for_each_state_instance([&](auto sid) {
-			if(sid == origin)
-				return;
-			if(!province::state_is_coastal(state, sid))
-				return;
+		std::vector<uint32_t> candidates;
+		std::vector<uint8_t> candidate_must_connect;
+		std::vector<float> candidate_mult;
+		std::vector<dcon::province_id> candidate_coasts;
 
-			auto coast_1 = province::state_get_coastal_capital(state, sid);
+		for(uint32_t j = 0; j < uint32_t(coastal_states.size()); j++) {
+			if(j == i)
+				continue;
+			auto& target = coastal_states[j];
 
-			auto target_market = state.world.state_instance_get_market_from_local_market(sid);
-			auto route = state.world.get_trade_route_by_province_pair(market, target_market);
+			auto route = state.world.get_trade_route_by_province_pair(origin.market, target.market);
 			if(route) {
-				state.world.trade_route_set_is_sea_route(route, true);
-				return;
+				existing_routes[i].push_back(j);
+				continue;
 			}
 
-			bool same_owner = false;
-			bool different_region = false;
-			bool capital_and_connected_region = false;
-
-			auto target_owner = state.world.state_instance_get_nation_from_state_ownership(sid);
-			if(target_owner == owner) {
-				same_owner = true;
-			}
-
-			auto capital_target = state.world.state_instance_get_capital(sid);
-			auto connected_region_target = state.world.province_get_connected_coast_id(coast_1);
-			if(connected_region != connected_region_target) {
-				different_region = true;
-			}
-
-			if(
-				(
-					capital_of_region[connected_region_target] == sid
-					&&
-					state_owner_capital_state == origin
-				)
-				||
-				(
-					state_owner_capital_state == sid
-					&&
-					capital_of_region[connected_region] == origin
-				)
-			) {
-				capital_and_connected_region = true;
-			}
-
-			auto naval_base_target = military::state_naval_base_level(state, sid);
-			auto state_target_owner_capital = state.world.nation_get_capital(target_owner);
-			auto state_target_owner_capital_state = state.world.province_get_state_membership(state_target_owner_capital);
-			auto continent_target = state.world.province_get_continent(coast_1);
-			auto continent_origin = state.world.province_get_continent(state_owner_capital);
+			bool same_owner = target.owner == origin.owner;
+			bool different_region = origin.connected_region != target.connected_region;
+			bool capital_and_connected_region =
+				(capital_of_region[target.connected_region] == target.sid && origin.owner_capital_state == origin.sid)
+				|| (origin.owner_capital_state == target.sid && capital_of_region[origin.connected_region] == origin.sid);
 
 			float mult = 1.f;
-			mult += std::min(naval_base_origin, naval_base_target) * naval_base_level_to_market_attractiveness;
+			mult += std::min(origin.naval_base, target.naval_base) * naval_base_level_to_market_attractiveness;
 			bool must_connect = same_owner && different_region && capital_and_connected_region;
-			
-			auto distance_approximation = province::direct_distance(state, coast_0, coast_1) / base_speed;
 
+			auto distance_approximation = province::direct_distance(state, origin.coast, target.coast) / base_speed;
 
-			float score_origin = population_origin;
-			float score_target = state.world.state_instance_get_demographics(sid, demographics::total);
-			if(capital_of_region[connected_region_target] == sid && capital_of_region[connected_region] == origin) {
-				score_origin = population_of_region[connected_region];
-				score_target = population_of_region[connected_region_target];
+			float score_origin = origin.population;
+			float score_target = target.population;
+			if(capital_of_region[target.connected_region] == target.sid && capital_of_region[origin.connected_region] == origin.sid) {
+				score_origin = population_of_region[origin.connected_region];
+				score_target = population_of_region[target.connected_region];
 				mult *= 20.f;
 			}
 
 			float score_approximation = mult * M * score_origin * score_target / distance_approximation / distance_approximation / distance_approximation;
 
 			if(!(score_approximation >= 1.f || must_connect)) {
-				return;
+				continue;
 			}
 
-			auto distance = 9999.f;
-			{
-				std::vector<dcon::province_id> path{ };
-				auto speed = base_speed;
-				dcon::province_id p_prev{ };
-				path = province::make_unowned_naval_path(state, coast_0, coast_1);
-				p_prev = coast_0;
-
-				auto ps = path.size();
-				auto effective_distance = 0.f;
-				auto worst_movement_cost = 0.f;
+			candidates.push_back(j);
+			candidate_must_connect.push_back(must_connect ? 1 : 0);
+			candidate_mult.push_back(mult * M * score_origin * score_target);
+			candidate_coasts.push_back(target.coast);
+		}
 
-				for(size_t i = 0; i < ps; i++) {
-					auto p_current = path[i];
-					auto adj = state.world.get_province_adjacency_by_province_pair(p_prev, p_current);
-					float local_distance = province::distance(state, adj);
-					float sum_mods =
-						state.world.province_get_modifier_values(p_current, sys::provincial_mod_offsets::movement_cost)
-						+ state.world.province_get_modifier_values(p_prev, sys::provincial_mod_offsets::movement_cost);
-					effective_distance += std::max(0.01f, local_distance * std::max(0.01f, (sum_mods * 2.f + 1.0f)));
-					if(sum_mods > worst_movement_cost)
-						worst_movement_cost = std::max(0.01f, sum_mods);
+		if(candidates.empty())
+			return;
 
-					p_prev = p_current;
-				}
-				distance = effective_distance / speed;
+		auto distances = effective_sea_distances(state, origin.coast, candidate_coasts);
+		for(size_t k = 0; k < candidates.size(); k++) {
+			auto distance = distances[k] / base_speed;
+			float score = candidate_mult[k] / distance / distance / distance;
+			if(score >= 1.f || candidate_must_connect[k]) {
+				new_routes[i].push_back(candidates[k]);
 			}
+		}
+	});
 
-			float score = mult * M * score_origin * score_target / distance / distance / distance;
-
-			if(score >= 1.f || must_connect) {
-				auto new_route = state.world.force_create_trade_route(market, target_market);
+	for(uint32_t i = 0; i < uint32_t(coastal_states.size()); i++) {
+		auto& existing = existing_routes[i];
+		auto& created = new_routes[i];
+		size_t e = 0;
+		size_t c = 0;
+		while(e < existing.size() || c < created.size()) {
+			auto j = (c == created.size() || (e < existing.size() && existing[e] < created[c])) ? existing[e++] : created[c++];
+			auto route = state.world.get_trade_route_by_province_pair(coastal_states[i].market, coastal_states[j].market);
+			if(route) {
+				state.world.trade_route_set_is_sea_route(route, true);
+			} else {
+				auto new_route = state.world.force_create_trade_route(coastal_states[i].market, coastal_states[j].market);
 				state.world.trade_route_set_is_sea_route(new_route, true);
 			}
-		});
-	});
+		}
+	}
 
 	// connect to each other coastal connectivity components:
 	std::vector<parent_link> best_parent;
 	std::vector<bool> parent_found;
 	parent_found.resize(state.world.market_size());
 
-	state.world.for_each_state_instance([&](auto origin) {
-		if(!province::state_is_coastal(state, origin))
-			return;
-		auto origin_market = state.world.state_instance_get_market_from_local_market(origin);
-		auto origin_capital = state.world.state_instance_get_capital(origin);
-		auto origin_owner = state.world.state_instance_get_nation_from_state_ownership(origin);
-		auto origin_connected_region = state.world.province_get_connected_coast_id(origin_capital);
+	for(auto& origin : coastal_states) {
+		auto origin_connected_region = state.world.province_get_connected_coast_id(origin.capital);
 		auto origin_connected_region_population = population_of_region[origin_connected_region];
-		if(origin != capital_of_region[origin_connected_region]) {
-			return;
+		if(origin.sid != capital_of_region[origin_connected_region]) {
+			continue;
 		}
 
-		auto origin_coast = province::state_get_coastal_capital(state, origin);
-
-		parent_found[origin_market.index()] = false;
+		bool origin_is_major_node = origin_connected_region_population > 0.7f * nation_to_max_population[origin.owner.index()];
 
-		bool origin_is_major_node = origin_connected_region_population > 0.7f * nation_to_max_population[origin_owner.index()];
-
-		state.world.for_each_state_instance([&](auto target) {
-			if(origin == target) {
-				return;
+		for(auto& target : coastal_states) {
+			if(origin.sid == target.sid) {
+				continue;
 			}
-			if(!province::state_is_coastal(state, target))
-				return;
-			auto target_market = state.world.state_instance_get_market_from_local_market(target);
-			auto target_capital = state.world.state_instance_get_capital(target);
-			auto target_owner = state.world.state_instance_get_nation_from_state_ownership(target);
-			auto target_coast = province::state_get_coastal_capital(state, target);
-			auto target_connected_region = state.world.province_get_connected_coast_id(target_coast);
-			auto target_connected_region_population = population_of_region[target_connected_region];
+			auto target_connected_region_population = population_of_region[target.connected_region];
 
-			if(target != capital_of_region[target_connected_region]) {
-				return;
+			if(target.sid != capital_of_region[target.connected_region]) {
+				continue;
 			}
 
-			if(target_owner != origin_owner) {
-				return;
+			if(target.owner != origin.owner) {
+				continue;
 			}
 
-
-			auto route = state.world.get_trade_route_by_province_pair(origin_market, target_market);
+			auto route = state.world.get_trade_route_by_province_pair(origin.market, target.market);
 			if(route) {
 				state.world.trade_route_set_is_sea_route(route, true);
-				return;
+				continue;
 			}
 
-			bool target_is_major_node = target_connected_region_population > 0.7f * nation_to_max_population[target_owner.index()];
+			bool target_is_major_node = target_connected_region_population > 0.7f * nation_to_max_population[target.owner.index()];
 
 			if(origin_is_major_node && target_is_major_node) {
-				auto new_route = state.world.force_create_trade_route(origin_market, target_market);
+				auto new_route = state.world.force_create_trade_route(origin.market, target.market);
 				state.world.trade_route_set_is_sea_route(new_route, true);
-				return;
+				continue;
 			}
 
 			if(origin_is_major_node) {
 				best_parent.push_back({
-					target_market,
-					origin_market,
-					province::direct_distance(state, target_capital, origin_capital)
+					target.market,
+					origin.market,
+					province::direct_distance(state, target.capital, origin.capital)
 				});
-				return;
+				continue;
 			}
 
 			if(target_is_major_node) {
 				best_parent.push_back({
-					origin_market,
-					target_market,
-					province::direct_distance(state, target_capital, origin_capital)
+					origin.market,
+					target.market,
+					province::direct_distance(state, target.capital, origin.capital)
 				});
-				return;
+				continue;
 			}
-		});
-	});
+		}
+	}
 
 	std::sort(best_parent.begin(), best_parent.end(), [&](parent_link& a, parent_link& b) {
 		if(a.dist < b.dist) {
@@ -730,8 +754,10 @@ bool global_national_state::is_global_flag_variable_set(dcon::global_flag_id id)
 }
 
 void global_national_state::set_global_flag_variable(dcon::global_flag_id id, bool state) {
-	if(id)
+	if(id) {
 		dcon::bit_vector_set(global_flag_variables.data(), id.index(), state);
+		global_flags_changed = true;
+	}
 }
 
 dcon::text_key name_from_tag(sys::state& state, dcon::national_identity_id tag) {
@@ -1948,6 +1974,7 @@ void adjust_relationship(sys::state& state, dcon::nation_id a, dcon::nation_id b
 }
 
 void create_nation_based_on_template(sys::state& state, dcon::nation_id n, dcon::nation_id base) {
+	trigger::mark_inputs_changed(state, n, trigger::inputs::all);
 	state.world.nation_set_is_civilized(n, state.world.nation_get_is_civilized(base));
 	state.world.nation_set_national_value(n, state.world.nation_get_national_value(base));
 	state.world.nation_set_tech_school(n, state.world.nation_get_tech_school(base));
@@ -2150,6 +2177,7 @@ void cleanup_nation(sys::state& state, dcon::nation_id n) {
 	state.world.delete_nation(n);
 	auto new_ident_holder = state.world.create_nation();
 	state.world.try_create_identity_holder(new_ident_holder, old_ident);
+	trigger::mark_inputs_changed(state, new_ident_holder, trigger::inputs::all);
 
 	for(auto o : state.world.in_nation) {
 		if(o.get_in_sphere_of() == n) {
@@ -3352,6 +3380,7 @@ void update_crisis(sys::state& state) {
 }
 
 void update_pop_acceptance(sys::state& state, dcon::nation_id n) {
+	trigger::mark_inputs_changed(state, n, trigger::inputs::culture);
 	auto pc = state.world.nation_get_primary_culture(n);
 	for(auto pr : state.world.nation_get_province_ownership(n)) {
 		for(auto pop : pr.get_province().get_pop_location()) {
@@ -73,6 +73,7 @@ enum class focus_type : uint8_t {
 struct global_national_state {
 	std::vector<triggered_modifier> triggered_modifiers;
 	std::vector<dcon::bitfield_type> global_flag_variables;
+	bool global_flags_changed = true; // cleared once cached trigger results have caught up with the global flags
 	std::vector<dcon::nation_id> nations_by_rank;
 
 	tagged_vector<dcon::text_key, dcon::national_flag_id> flag_variable_names;
@@ -2,6 +2,10 @@
 #include "nations.hpp"
 #include <charconv>
 #include <algorithm>
+#include <bit>
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
 
 namespace parsers {
 bool ignorable_char(char c) {
@@ -95,13 +99,72 @@ char const* scan_for_not_match(char const* start, char const* end, int32_t& curr
 	return start;
 }
 
+// the structural character scans below test a whole block of bytes per step; the remainder of the
+// file (and builds without simd support) falls back to the plain per-character loop
+
+#if defined(__AVX2__)
+#define PARSERS_BLOCK_SCAN
+constexpr int32_t scan_block_size = 32;
+template<char... C>
+inline uint32_t block_match_mask(char const* p) {
+	auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+	auto acc = _mm256_setzero_si256();
+	((acc = _mm256_or_si256(acc, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(C)))), ...);
+	return uint32_t(_mm256_movemask_epi8(acc));
+}
+#elif defined(__SSE2__) || defined(_M_X64)
+#define PARSERS_BLOCK_SCAN
+constexpr int32_t scan_block_size = 16;
+template<char... C>
+inline uint32_t block_match_mask(char const* p) {
+	auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+	auto acc = _mm_setzero_si128();
+	((acc = _mm_or_si128(acc, _mm_cmpeq_epi8(v, _mm_set1_epi8(C)))), ...);
+	return uint32_t(_mm_movemask_epi8(acc));
+}
+#endif
+
+// returns the first character in [start, end) that is (find_match = true) or is not (find_match = false)
+// one of C..., counting the newlines passed over
+template<bool find_match, char... C>
+char const* scan_for_chars(char const* start, char const* end, int32_t& current_line) {
+#ifdef PARSERS_BLOCK_SCAN
+	{
+		constexpr uint32_t full_block = uint32_t((uint64_t(1) << scan_block_size) - 1);
+		// when looking for a newline, no newline can be skipped over
+		constexpr bool count_newlines = !find_match || ((C != '\n') && ...);
+		while(end - start >= scan_block_size) {
+			auto found = block_match_mask<C...>(start);
+			if constexpr(!find_match)
+				found = ~found & full_block;
+			uint32_t newlines = 0;
+			if constexpr(count_newlines)
+				newlines = block_match_mask<'\n'>(start);
+			if(found != 0) {
+				auto const offset = std::countr_zero(found);
+				if constexpr(count_newlines)
+					current_line += std::popcount(newlines & ((uint32_t(1) << offset) - 1));
+				return start + offset;
+			}
+			if constexpr(count_newlines)
+				current_line += std::popcount(newlines);
+			start += scan_block_size;
+		}
+	}
+#endif
+	if constexpr(find_match)
+		return scan_for_match(start, end, current_line, [](char c) { return ((c == C) || ...); });
+	else
+		return scan_for_not_match(start, end, current_line, [](char c) { return ((c == C) || ...); });
+}
+
 char const* advance_position_to_next_line(char const* start, char const* end, int32_t& current_line) {
-	auto const start_lterm = scan_for_match(start, end, current_line, line_termination);
+	auto const start_lterm = scan_for_chars<true, '\r', '\n'>(start, end, current_line);
 	return scan_for_not_match(start_lterm, end, current_line, line_termination);
 }
 
 char const* advance_position_to_non_whitespace(char const* start, char const* end, int32_t& current_line) {
-	return scan_for_not_match(start, end, current_line, ignorable_char);
+	return scan_for_chars<false, ' ', '\r', '\f', '\n', '\t', ',', ';'>(start, end, current_line);
 }
 
 char const* advance_position_to_non_comment(char const* start, char const* end, int32_t& current_line) {
@@ -114,7 +177,8 @@ char const* advance_position_to_non_comment(char const* start, char const* end,
 }
 
 char const* advance_position_to_breaking_char(char const* start, char const* end, int32_t& current_line) {
-	return scan_for_match(start, end, current_line, breaking_char);
+	return scan_for_chars<true, ' ', '\r', '\f', '\n', '\t', ',', ';', '{', '}', '!', '=', '<', '>', '#'>(start, end,
+			current_line);
 }
 
 token_and_type token_generator::internal_next() {
@@ -130,11 +194,11 @@ token_and_type token_generator::internal_next() {
 			position = non_ws + 1;
 			return token_and_type{std::string_view(non_ws, 1), current_line, token_type::close_brace};
 		} else if(*non_ws == '\"') {
-			auto const close = scan_for_match(non_ws + 1, file_end, current_line, double_quote_termination);
+			auto const close = scan_for_chars<true, '\r', '\n', '\"'>(non_ws + 1, file_end, current_line);
 			position = close + 1;
 			return token_and_type{std::string_view(non_ws + 1, close - (non_ws + 1)), current_line, token_type::quoted_string};
 		} else if(*non_ws == '\'') {
-			auto const close = scan_for_match(non_ws + 1, file_end, current_line, single_quote_termination);
+			auto const close = scan_for_chars<true, '\r', '\n', '\''>(non_ws + 1, file_end, current_line);
 			position = close + 1;
 			return token_and_type{std::string_view(non_ws + 1, close - (non_ws + 1)), current_line, token_type::quoted_string};
 		} else if(has_fixed_prefix(non_ws, file_end, "==") || has_fixed_prefix(non_ws, file_end, "<=") ||
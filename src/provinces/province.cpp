@@ -5,6 +5,8 @@
 #include "nations.hpp"
 #include "system_state.hpp"
 #include <vector>
+#include <algorithm>
+#include <functional>
 #include "rebels.hpp"
 #include "math_fns.hpp"
 #include "prng.hpp"
@@ -61,11 +63,12 @@ bool sea_province_is_adjacent_to_accessible_coast(sys::state& state, dcon::provi
 }
 
 
-void update_connected_regions(sys::state& state) {
-	if(!state.adjacency_data_out_of_date)
-		return;
+static bool is_land_passage(sys::state& state, dcon::province_adjacency_id adj) {
+	// not entering sea, not impassible
+	return (state.world.province_adjacency_get_type(adj) & (province::border::coastal_bit | province::border::impassible_bit)) == 0;
+}
 
-	state.adjacency_data_out_of_date = false;
+static void recompute_connected_regions(sys::state& state) {
 	state.world.nation_adjacency_resize(0);
 
 	{
@@ -74,6 +77,7 @@ void update_connected_regions(sys::state& state) {
 		static std::vector<dcon::province_id> to_fill_list;
 		uint16_t current_fill_id = 0;
 		state.province_definitions.connected_region_is_coastal.clear();
+		state.province_definitions.free_connected_region_ids.clear();
 
 		to_fill_list.reserve(state.world.province_size());
 
@@ -114,9 +118,6 @@ void update_connected_regions(sys::state& state) {
 				to_fill_list.clear();
 			}
 		}
-
-		// we also invalidate wargoals here that are now unowned
-		military::invalidate_unowned_wargoals(state);
 	}
 
 	{
@@ -125,6 +126,7 @@ void update_connected_regions(sys::state& state) {
 		static std::vector<dcon::province_id> to_fill_list;
 		uint16_t current_fill_id = 0;
 		to_fill_list.reserve(state.world.province_size());
+		state.province_definitions.free_connected_coast_ids.clear();
 
 		for(int32_t i = state.province_definitions.first_sea_province.index(); i-- > 0;) {
 			dcon::province_id id{ dcon::province_id::value_base_t(i) };
@@ -164,8 +166,214 @@ void update_connected_regions(sys::state& state) {
 				to_fill_list.clear();
 			}
 		}
+
+		state.province_definitions.connected_coast_id_count = current_fill_id;
+	}
+}
+
+/*
+Re-floods only the regions touched by an ownership change. A region that contains neither a changed province nor one
+of its neighbours keeps every province and every border it had, so it is left alone. The touched regions are gathered
+while their old ids are still in place (a region is exactly what can be reached from one of its provinces through
+neighbours with the same id), cleared, and then flooded again with the usual rule. The flood cannot leak into an
+untouched region because those keep a non-zero id. Released ids are recycled before new ones are handed out, so ids
+stay as dense as after a full recompute.
+*/
+template<typename GET_ID, typename SET_ID, typename CAN_START, typename JOINS, typename NEW_ID, typename ON_REGION>
+static void refill_touched_regions(sys::state& state, std::vector<dcon::province_id> const& touched, std::vector<uint16_t>& free_ids,
+	GET_ID&& get_id, SET_ID&& set_id, CAN_START&& can_start, JOINS&& joins, NEW_ID&& new_id, ON_REGION&& on_region) {
+
+	static std::vector<dcon::province_id> members;
+	static std::vector<dcon::province_id> to_fill_list;
+	static std::vector<dcon::province_id> region;
+	members.clear();
+
+	for(auto p : touched) {
+		auto old_id = get_id(p);
+		if(old_id == 0)
+			continue;
+
+		free_ids.push_back(old_id);
+		set_id(p, uint16_t(0));
+		members.push_back(p);
+		to_fill_list.push_back(p);
+
+		while(!to_fill_list.empty()) {
+			auto current_id = to_fill_list.back();
+			to_fill_list.pop_back();
+
+			for(auto rel : state.world.province_get_province_adjacency(current_id)) {
+				if(is_land_passage(state, rel)) {
+					auto other = rel.get_connected_provinces(0).id == current_id ? rel.get_connected_provinces(1) : rel.get_connected_provinces(0);
+					if(get_id(other) == old_id) {
+						set_id(other, uint16_t(0));
+						members.push_back(other);
+						to_fill_list.push_back(other);
+					}
+				}
+			}
+		}
 	}
 
+	// hand out the lowest ids first
+	std::sort(free_ids.begin(), free_ids.end(), std::greater<uint16_t>());
+
+	for(auto p : members) {
+		if(get_id(p) != 0 || !can_start(p))
+			continue;
+
+		uint16_t fill_id = 0;
+		if(!free_ids.empty()) {
+			fill_id = free_ids.back();
+			free_ids.pop_back();
+		} else {
+			fill_id = new_id();
+		}
+
+		region.clear();
+		set_id(p, fill_id);
+		to_fill_list.push_back(p);
+
+		while(!to_fill_list.empty()) {
+			auto current_id = to_fill_list.back();
+			to_fill_list.pop_back();
+			region.push_back(current_id);
+
+			for(auto rel : state.world.province_get_province_adjacency(current_id)) {
+				if(is_land_passage(state, rel)) {
+					auto other = rel.get_connected_provinces(0).id == current_id ? rel.get_connected_provinces(1) : rel.get_connected_provinces(0);
+					if(get_id(other) == 0 && joins(current_id, other)) {
+						set_id(other, fill_id);
+						to_fill_list.push_back(other);
+					}
+				}
+			}
+		}
+
+		on_region(fill_id, region);
+	}
+}
+
+static bool nations_share_land_border(sys::state& state, dcon::nation_id a, dcon::nation_id b) {
+	for(auto po : state.world.nation_get_province_ownership(a)) {
+		auto p = po.get_province();
+		for(auto rel : p.get_province_adjacency()) {
+			if(is_land_passage(state, rel)) {
+				auto other = rel.get_connected_provinces(0).id == p.id ? rel.get_connected_provinces(1) : rel.get_connected_provinces(0);
+				if(other.get_nation_from_province_ownership() == b)
+					return true;
+			}
+		}
+	}
+	return false;
+}
+
+static void update_changed_connected_regions(sys::state& state) {
+	auto& changes = state.pending_ownership_changes;
+
+	// owners from before this batch of changes; when a province changed hands twice the earliest entry wins
+	static std::vector<dcon::nation_id> previous_owner;
+	static std::vector<bool> was_changed;
+	previous_owner.resize(state.world.province_size());
+	was_changed.resize(state.world.province_size(), false);
+	for(auto i = changes.size(); i-- > 0;) {
+		previous_owner[changes[i].province.index()] = changes[i].old_owner;
+		was_changed[changes[i].province.index()] = true;
+	}
+	auto owner_before = [&](dcon::province_id p) {
+		return was_changed[p.index()] ? previous_owner[p.index()] : state.world.province_get_nation_from_province_ownership(p);
+	};
+
+	static std::vector<dcon::province_id> touched;
+	static std::vector<std::pair<dcon::nation_id, dcon::nation_id>> lost_borders;
+	touched.clear();
+	lost_borders.clear();
+
+	for(auto& c : changes) {
+		auto owner = state.world.province_get_nation_from_province_ownership(c.province);
+		auto old_owner = previous_owner[c.province.index()];
+		touched.push_back(c.province);
+
+		for(auto rel : state.world.province_get_province_adjacency(c.province)) {
+			if(is_land_passage(state, rel)) {
+				auto other = rel.get_connected_provinces(0).id == c.province ? rel.get_connected_provinces(1) : rel.get_connected_provinces(0);
+				touched.push_back(other);
+
+				auto other_owner = other.get_nation_from_province_ownership();
+				if(owner != other_owner) {
+					state.world.try_create_nation_adjacency(owner, other_owner);
+				}
+				auto other_old_owner = owner_before(other);
+				if(old_owner != other_old_owner) {
+					lost_borders.emplace_back(old_owner, other_old_owner);
+				}
+			}
+		}
+	}
+
+	// borders that existed before the changes survive only if some other pair of provinces still carries them
+	for(auto [a, b] : lost_borders) {
+		if(!a)
+			std::swap(a, b);
+		if(!state.world.nation_is_valid(a) || (b && !state.world.nation_is_valid(b)))
+			continue; // deleted nations take their adjacencies with them
+		auto adj = state.world.get_nation_adjacency_by_nation_adjacency_pair(a, b);
+		if(adj && !nations_share_land_border(state, a, b))
+			state.world.delete_nation_adjacency(adj);
+	}
+	for(auto& c : changes) {
+		was_changed[c.province.index()] = false;
+	}
+
+	auto& is_coastal = state.province_definitions.connected_region_is_coastal;
+	refill_touched_regions(state, touched, state.province_definitions.free_connected_region_ids,
+		[&](dcon::province_id p) { return state.world.province_get_connected_region_id(p); },
+		[&](dcon::province_id p, uint16_t v) { state.world.province_set_connected_region_id(p, v); },
+		[&](dcon::province_id) { return true; },
+		[&](dcon::province_id a, dcon::province_id b) {
+			return state.world.province_get_nation_from_province_ownership(a) == state.world.province_get_nation_from_province_ownership(b);
+		},
+		[&]() {
+			is_coastal.push_back(false);
+			return uint16_t(is_coastal.size());
+		},
+		[&](uint16_t id, std::vector<dcon::province_id> const& region) {
+			bool found_coast = false;
+			for(auto p : region)
+				found_coast = found_coast || state.world.province_get_is_coast(p);
+			is_coastal[id - 1] = found_coast;
+		});
+
+	auto& coast_count = state.province_definitions.connected_coast_id_count;
+	refill_touched_regions(state, touched, state.province_definitions.free_connected_coast_ids,
+		[&](dcon::province_id p) { return state.world.province_get_connected_coast_id(p); },
+		[&](dcon::province_id p, uint16_t v) { state.world.province_set_connected_coast_id(p, v); },
+		[&](dcon::province_id p) { return state.world.province_get_is_coast(p); },
+		[&](dcon::province_id a, dcon::province_id b) {
+			return state.world.province_get_nation_from_province_ownership(a) == state.world.province_get_nation_from_province_ownership(b)
+				&& state.world.province_get_is_coast(a) == state.world.province_get_is_coast(b);
+		},
+		[&]() {
+			return ++coast_count;
+		},
+		[&](uint16_t, std::vector<dcon::province_id> const&) { });
+}
+
+void update_connected_regions(sys::state& state) {
+	if(!state.adjacency_data_out_of_date && state.pending_ownership_changes.empty())
+		return;
+
+	if(state.adjacency_data_out_of_date) {
+		recompute_connected_regions(state);
+	} else {
+		update_changed_connected_regions(state);
+	}
+	state.adjacency_data_out_of_date = false;
+	state.pending_ownership_changes.clear();
+
+	// we also invalidate wargoals here that are now unowned
+	military::invalidate_unowned_wargoals(state);
+
 
 	static ankerl::unordered_dense::map<dcon::province_id::value_base_t, std::vector<std::pair<size_t, size_t>>> province_to_borders{ };
 	if(province_to_borders.empty()) {
@@ -1056,7 +1264,9 @@ void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation
 	if(new_owner == old_owner)
 		return;
 
-	state.adjacency_data_out_of_date = true;
+	trigger::mark_inputs_changed(state, old_owner, trigger::inputs::ownership);
+	trigger::mark_inputs_changed(state, new_owner, trigger::inputs::ownership);
+	state.pending_ownership_changes.push_back(ownership_change{ id, old_owner });
 	state.national_cached_values_out_of_date = true;
 
 	bool state_is_new = false;
@@ -2529,6 +2739,42 @@ std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::prov
 	return path_result;
 }
 
+void mark_safe_land_reachable(sys::state& state, dcon::province_id start, dcon::nation_id nation_as, std::vector<uint8_t>& reachable) {
+	reachable.assign(state.world.province_size(), 0);
+	if(!start)
+		return;
+
+	// expanded holds the provinces that the path may pass through; any province next to one of them can be a destination
+	std::vector<uint8_t> expanded(state.world.province_size(), 0);
+	std::vector<dcon::province_id> to_expand;
+	to_expand.push_back(start);
+	expanded[start.index()] = 1;
+
+	while(!to_expand.empty()) {
+		auto current = to_expand.back();
+		to_expand.pop_back();
+
+		for(auto adj : state.world.province_get_province_adjacency(current)) {
+			auto other_prov =
+				adj.get_connected_provinces(0) == current ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+			if(is_adjacency_impassable(state, nation_as, adj.id))
+				continue;
+
+			reachable[other_prov.id.index()] = 1;
+			if(!expanded[other_prov.id.index()]
+				&& other_prov.id.index() < state.province_definitions.first_sea_province.index()
+				&& other_prov.get_siege_progress() == 0
+				&& has_safe_access_to_province(state, nation_as, other_prov)) {
+
+				expanded[other_prov.id.index()] = 1;
+				to_expand.push_back(other_prov);
+			}
+		}
+	}
+	// make_safe_land_path never returns a path to its own starting point
+	reachable[start.index()] = 0;
+}
+
 // used for land trade
 std::vector<dcon::province_id> make_unowned_path(sys::state& state, dcon::province_id start, dcon::province_id end) {
 	std::vector<province_and_distance> path_heap;
@@ -22,6 +22,9 @@ struct global_provincial_state {
 	std::vector<dcon::province_id> canal_provinces;
 	ankerl::unordered_dense::map<dcon::modifier_id, dcon::gfx_object_id, sys::modifier_hash> terrain_to_gfx_map;
 	std::vector<bool> connected_region_is_coastal;
+	std::vector<uint16_t> free_connected_region_ids; // released by incremental updates, handed out again before new ids
+	std::vector<uint16_t> free_connected_coast_ids;
+	uint16_t connected_coast_id_count = 0;
 	dcon::province_id first_sea_province;
 	dcon::modifier_id europe;
 	dcon::modifier_id asia;
@@ -31,6 +34,11 @@ struct global_provincial_state {
 	dcon::modifier_id oceania;
 };
 
+struct ownership_change {
+	dcon::province_id province;
+	dcon::nation_id old_owner;
+};
+
 struct naval_range_data {
 	float distance;
 	bool is_reachable;
@@ -137,6 +145,8 @@ bool has_safe_access_to_province(sys::state& state, dcon::nation_id nation_as, d
 std::vector<dcon::province_id> make_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as, dcon::army_id a);
 // pathfind through non-enemy controlled, not under siege provinces
 std::vector<dcon::province_id> make_safe_land_path(sys::state& state, dcon::province_id start, dcon::province_id end, dcon::nation_id nation_as);
+// flood fill version of the above: sets reachable[p] to 1 for every province that make_safe_land_path could reach from start
+void mark_safe_land_reachable(sys::state& state, dcon::province_id start, dcon::nation_id nation_as, std::vector<uint8_t>& reachable);
 std::vector<dcon::province_id> make_unowned_path(sys::state& state, dcon::province_id start, dcon::province_id end);
 // used for rebel unit and black-flagged unit pathfinding
 std::vector<dcon::province_id> make_unowned_land_path(sys::state& state, dcon::province_id start, dcon::province_id end);
@@ -2043,10 +2043,12 @@ uint32_t ef_change_tag_no_core_switch_culture(EFFECT_PARAMTERS) {
 }
 uint32_t ef_set_country_flag(EFFECT_PARAMTERS) {
 	ws.world.nation_set_flag_variables(trigger::to_nation(primary_slot), trigger::payload(tval[1]).natf_id, true);
+	trigger::mark_inputs_changed(ws, trigger::to_nation(primary_slot), trigger::inputs::flags);
 	return 0;
 }
 uint32_t ef_clr_country_flag(EFFECT_PARAMTERS) {
 	ws.world.nation_set_flag_variables(trigger::to_nation(primary_slot), trigger::payload(tval[1]).natf_id, false);
+	trigger::mark_inputs_changed(ws, trigger::to_nation(primary_slot), trigger::inputs::flags);
 	return 0;
 }
 uint32_t ef_military_access(EFFECT_PARAMTERS) {
@@ -4366,6 +4368,7 @@ uint32_t ef_set_variable(EFFECT_PARAMTERS) {
 	auto amount = trigger::read_float_from_payload(tval + 2);
 	assert(std::isfinite(amount));
 	ws.world.nation_set_variables(trigger::to_nation(primary_slot), trigger::payload(tval[1]).natv_id, amount);
+	trigger::mark_inputs_changed(ws, trigger::to_nation(primary_slot), trigger::inputs::flags);
 	return 0;
 }
 uint32_t ef_change_variable(EFFECT_PARAMTERS) {
@@ -4374,6 +4377,7 @@ uint32_t ef_change_variable(EFFECT_PARAMTERS) {
 
 	auto& current = ws.world.nation_get_variables(trigger::to_nation(primary_slot), trigger::payload(tval[1]).natv_id);
 	ws.world.nation_set_variables(trigger::to_nation(primary_slot), trigger::payload(tval[1]).natv_id, current + amount);
+	trigger::mark_inputs_changed(ws, trigger::to_nation(primary_slot), trigger::inputs::flags);
 	return 0;
 }
 uint32_t ef_ideology(EFFECT_PARAMTERS) {
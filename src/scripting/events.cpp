@@ -524,6 +524,27 @@ void update_events(sys::state& state) {
 		auto t = state.world.free_national_event_get_trigger(id);
 
 		if(state.world.free_national_event_get_only_once(id) == false || state.world.free_national_event_get_has_been_triggered(id) == false) {
+			auto const& filter = state.free_national_event_prefilters[id];
+			if(!trigger::prefilter_passes_globally(state, filter))
+				return;
+			if(trigger::prefilter_limits_candidates(filter)) {
+				// the trigger can hold for at most one nation, so test only that one
+				auto n = trigger::prefilter_candidate(state, filter);
+				if(!n || state.world.nation_get_owned_province_count(n) == 0)
+					return;
+				if(t && !trigger::evaluate(state, t, trigger::to_generic(n), trigger::to_generic(n), 0))
+					return;
+				auto chances = mod ? trigger::evaluate_multiplicative_modifier(state, mod, trigger::to_generic(n), trigger::to_generic(n), 0) : 1.0f;
+				auto adj_chance = 1.0f - (chances <= 1.0f ? 1.0f : 1.0f / chances);
+				auto adj_chance_2 = adj_chance * adj_chance;
+				auto adj_chance_4 = adj_chance_2 * adj_chance_2;
+				auto adj_chance_8 = adj_chance_4 * adj_chance_4;
+				auto adj_chance_16 = adj_chance_8 * adj_chance_8;
+				if(float(rng::get_random(state, uint32_t((i << 1) ^ n.index())) & 0xFFFFFF) / float(0xFFFFFF + 1) >= adj_chance_16) {
+					events_triggered.local().push_back(event_nation_pair{ n, id });
+				}
+				return;
+			}
 			ve::execute_serial_fast<dcon::nation_id>(state.world.nation_size(), [&](auto ids) {
 				/*
 				For national events: the base factor (scaled to days) is multiplied with all modifiers that hold. If the value is
@@ -578,7 +599,8 @@ void update_events(sys::state& state) {
 		auto mod = state.world.free_provincial_event_get_mtth(id);
 		auto t = state.world.free_provincial_event_get_trigger(id);
 
-		if(state.world.free_provincial_event_get_only_once(id) == false || state.world.free_provincial_event_get_has_been_triggered(id) == false) {
+		if((state.world.free_provincial_event_get_only_once(id) == false || state.world.free_provincial_event_get_has_been_triggered(id) == false)
+			&& trigger::prefilter_passes_globally(state, state.free_provincial_event_prefilters[id])) {
 			ve::execute_serial_fast<dcon::province_id>(uint32_t(state.province_definitions.first_sea_province.index()),
 					[&](ve::contiguous_tags<dcon::province_id> ids) {
 						/*
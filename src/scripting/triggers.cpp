@@ -5935,4 +5935,156 @@ ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::contiguous
 	return test_trigger_generic<ve::mask_vector>(data, state, primary, this_slot, from_slot);
 }
 
+inline bool is_equality_association(uint16_t code) {
+	auto const a = code & trigger::association_mask;
+	return a != trigger::association_gt && a != trigger::association_lt && a != trigger::association_ne;
+}
+
+inline void add_single_to_prefilter(sys::trigger_prefilter& f, uint16_t const* tval) {
+	switch(tval[0] & trigger::code_mask) {
+	case trigger::tag_tag:
+		if(is_equality_association(tval[0]))
+			f.tag = trigger::payload(tval[1]).tag_id;
+		break;
+	case trigger::exists_tag:
+		if(is_equality_association(tval[0]))
+			f.existing_tag = trigger::payload(tval[1]).tag_id;
+		break;
+	case trigger::owns:
+		if(is_equality_association(tval[0]))
+			f.owned_province = trigger::payload(tval[1]).prov_id;
+		break;
+	case trigger::year:
+	{
+		auto const v = int32_t(tval[1]);
+		switch(tval[0] & trigger::association_mask) {
+		case trigger::association_eq:
+			f.min_year = std::max(f.min_year, v);
+			f.max_year = std::min(f.max_year, v);
+			break;
+		case trigger::association_gt:
+			f.min_year = std::max(f.min_year, v + 1);
+			break;
+		case trigger::association_lt:
+			f.max_year = std::min(f.max_year, v - 1);
+			break;
+		case trigger::association_le:
+			f.max_year = std::min(f.max_year, v);
+			break;
+		case trigger::association_ne:
+			break;
+		case trigger::association_ge:
+		default:
+			f.min_year = std::max(f.min_year, v);
+			break;
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+void add_to_prefilter(sys::trigger_prefilter& f, uint16_t const* data) {
+	if((data[0] & trigger::code_mask) == trigger::generic_scope) {
+		if((data[0] & trigger::is_disjunctive_scope) != 0)
+			return;
+
+		auto const source_size = 1 + get_trigger_scope_payload_size(data);
+		auto sub_units_start = data + 2;
+		while(sub_units_start < data + source_size) {
+			if((sub_units_start[0] & trigger::code_mask) < trigger::first_scope_code)
+				add_single_to_prefilter(f, sub_units_start);
+			sub_units_start += 1 + get_trigger_payload_size(sub_units_start);
+		}
+	} else if((data[0] & trigger::code_mask) < trigger::first_scope_code) {
+		add_single_to_prefilter(f, data);
+	}
+}
+void add_to_prefilter(sys::state& state, sys::trigger_prefilter& f, dcon::trigger_key key) {
+	if(key)
+		add_to_prefilter(f, state.trigger_data.data() + state.trigger_data_indices[key.index() + 1]);
+}
+
+bool prefilter_passes_globally(sys::state& state, sys::trigger_prefilter const& f) {
+	if(f.min_year != std::numeric_limits<int32_t>::min() || f.max_year != std::numeric_limits<int32_t>::max()) {
+		auto const year = state.current_date.to_ymd(state.start_date).year;
+		if(year < f.min_year || year > f.max_year)
+			return false;
+	}
+	if(f.existing_tag) {
+		auto holder = state.world.national_identity_get_nation_from_identity_holder(f.existing_tag);
+		if(state.world.nation_get_owned_province_count(holder) == 0)
+			return false;
+	}
+	return true;
+}
+
+dcon::nation_id prefilter_candidate(sys::state& state, sys::trigger_prefilter const& f) {
+	dcon::nation_id result;
+	if(f.tag) {
+		result = state.world.national_identity_get_nation_from_identity_holder(f.tag);
+		if(!result)
+			return dcon::nation_id{};
+	}
+	if(f.owned_province) {
+		auto owner = state.world.province_get_nation_from_province_ownership(f.owned_province);
+		if(!owner || (result && owner != result))
+			return dcon::nation_id{};
+		result = owner;
+	}
+	return result;
+}
+
+uint32_t read_inputs(uint16_t const* data) {
+	uint32_t result = 0;
+	trigger::recurse_over_triggers(const_cast<uint16_t*>(data), [&](uint16_t* tval) {
+		switch(tval[0] & trigger::code_mask) {
+		case trigger::generic_scope:
+		case trigger::always:
+			break;
+		case trigger::technology:
+		case trigger::invention:
+			result |= inputs::technology;
+			break;
+		case trigger::government_nation:
+		case trigger::is_next_reform_nation:
+		case trigger::is_next_rreform_nation:
+		case trigger::variable_issue_group_name_nation:
+		case trigger::variable_reform_group_name_nation:
+			result |= inputs::politics;
+			break;
+		case trigger::primary_culture:
+		case trigger::accepted_culture:
+			result |= inputs::culture;
+			break;
+		case trigger::tag_tag:
+		case trigger::owns:
+			result |= inputs::ownership;
+			break;
+		case trigger::has_country_flag:
+		case trigger::check_variable:
+			result |= inputs::flags;
+			break;
+		case trigger::has_global_flag:
+			result |= inputs::global_flags;
+			break;
+		default:
+			result |= inputs::untracked;
+			break;
+		}
+	});
+	return result;
+}
+uint32_t read_inputs(sys::state& state, dcon::trigger_key key) {
+	if(!key)
+		return 0;
+	return read_inputs(state.trigger_data.data() + state.trigger_data_indices[key.index() + 1]);
+}
+
+void mark_inputs_changed(sys::state& state, dcon::nation_id n, uint32_t changed) {
+	if(n)
+		state.world.nation_set_clean_trigger_inputs(n, state.world.nation_get_clean_trigger_inputs(n) & ~changed);
+}
+
 } // namespace trigger
@@ -192,4 +192,35 @@ ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::contiguou
 		ve::contiguous_tags<int32_t> this_slot, int32_t from_slot);
 ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::contiguous_tags<int32_t> primary,
 		ve::contiguous_tags<int32_t> this_slot, int32_t from_slot);
+// extracts the cheap necessary conditions from the top level conjunction of a trigger with a nation in the main slot
+// and merges them into f; conditions nested in or / not / other scopes are ignored
+void add_to_prefilter(sys::trigger_prefilter& f, uint16_t const* data);
+void add_to_prefilter(sys::state& state, sys::trigger_prefilter& f, dcon::trigger_key key);
+// tests the parts of the prefilter that do not depend on the nation being evaluated
+bool prefilter_passes_globally(sys::state& state, sys::trigger_prefilter const& f);
+// true if the prefilter pins the trigger down to (at most) one nation
+inline bool prefilter_limits_candidates(sys::trigger_prefilter const& f) {
+	return bool(f.tag) || bool(f.owned_province);
+}
+// the only nation that can pass the trigger, if prefilter_limits_candidates; may be invalid
+dcon::nation_id prefilter_candidate(sys::state& state, sys::trigger_prefilter const& f);
+
+// coarse classes of game state that a trigger with a nation in the main slot may read
+// used to decide when a cached trigger result has to be recomputed for a nation
+namespace inputs {
+inline constexpr uint32_t technology = 0x00000001; // technologies and inventions
+inline constexpr uint32_t politics = 0x00000002; // issues, reforms and government type
+inline constexpr uint32_t culture = 0x00000004; // primary and accepted cultures
+inline constexpr uint32_t ownership = 0x00000008; // owned provinces and the held tag
+inline constexpr uint32_t flags = 0x00000010; // national flags and variables
+inline constexpr uint32_t global_flags = 0x00000020;
+inline constexpr uint32_t untracked = 0x80000000; // reads something else (dates, random, other nations): never cache
+inline constexpr uint32_t all = 0xFFFFFFFF;
+}
+
+uint32_t read_inputs(uint16_t const* data);
+uint32_t read_inputs(sys::state& state, dcon::trigger_key key);
+// must be called whenever one of the tracked inputs of a nation is altered after the scenario has been loaded
+void mark_inputs_changed(sys::state& state, dcon::nation_id n, uint32_t changed);
+
 } // namespace trigger
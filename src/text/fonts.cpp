@@ -280,6 +280,8 @@ void dead_reckoning(float distance_map[dr_size * dr_size], bool const in_map[dr_
 
 void font_manager::change_locale(sys::state& state, dcon::locale_id l) {
 	current_locale = l;
+	// features, script and the font array itself may all change with the locale
+	clear_shaped_text();
 
 	uint32_t end_language = 0;
 	auto locale_name = state.world.locale_get_locale_name(l);
@@ -436,6 +438,7 @@ font& font_manager::get_font(sys::state& state, font_selection s) {
 }
 
 void font_manager::load_font(font& fnt, char const* file_data, uint32_t file_size) {
+	clear_shaped_text();
 	fnt.file_data = std::unique_ptr<FT_Byte[]>(new FT_Byte[file_size]);
 
 	memcpy(fnt.file_data.get(), file_data, file_size);
@@ -594,6 +597,10 @@ void font::remake_cache(sys::state& state, font_selection type, stored_glyphs& t
 		return;
 	}
 
+	auto key = font_manager::shaped_text_key(*this, type, shaping_mode::utf16, source.data(), source.size() * sizeof(uint16_t));
+	if(state.font_collection.find_shaped_text(key, txt))
+		return;
+
 	auto locale = state.font_collection.get_current_locale();
 	UBiDi* para;
 	UErrorCode errorCode = U_ZERO_ERROR;
@@ -654,6 +661,7 @@ void font::remake_cache(sys::state& state, font_selection type, stored_glyphs& t
 	}
 
 	ubidi_close(para);
+	state.font_collection.store_shaped_text(std::move(key), txt);
 }
 
 void font::remake_bidiless_cache(sys::state& state, font_selection type, stored_glyphs& txt, std::span<uint16_t> source) {
@@ -671,6 +679,10 @@ void font::remake_bidiless_cache(sys::state& state, font_selection type, stored_
 		return;
 	}
 
+	auto key = font_manager::shaped_text_key(*this, type, shaping_mode::utf16_no_bidi, source.data(), source.size() * sizeof(uint16_t));
+	if(state.font_collection.find_shaped_text(key, txt))
+		return;
+
 	auto locale = state.font_collection.get_current_locale();
 	
 	hb_feature_t feature_buffer[10];
@@ -707,6 +719,7 @@ void font::remake_bidiless_cache(sys::state& state, font_selection type, stored_
 	if(state.world.locale_get_native_rtl(locale)) {
 		std::reverse(txt.glyph_info.begin(), txt.glyph_info.end());
 	}
+	state.font_collection.store_shaped_text(std::move(key), txt);
 }
 
 void font::remake_cache(stored_glyphs& txt, std::string const& s) {
@@ -760,6 +773,10 @@ void font::remake_cache(sys::state& state, font_selection type, stored_glyphs& t
 		return;
 	}
 
+	auto key = font_manager::shaped_text_key(*this, type, shaping_mode::utf8, s.data(), s.size());
+	if(state.font_collection.find_shaped_text(key, txt))
+		return;
+
 	auto locale = state.font_collection.get_current_locale();
 	if(state.world.locale_get_native_rtl(locale) == false) {
 		hb_buffer_clear_contents(hb_buf);
@@ -870,6 +887,7 @@ void font::remake_cache(sys::state& state, font_selection type, stored_glyphs& t
 
 		ubidi_close(para);
 	}
+	state.font_collection.store_shaped_text(std::move(key), txt);
 }
 
 float font::text_extent(sys::state& state, stored_glyphs const& txt, uint32_t starting_offset, uint32_t count, int32_t size) {
@@ -886,6 +904,49 @@ void font_manager::set_classic_fonts(bool v) {
 	for(auto& fnt : font_array) {
 		fnt.only_raw_codepoints = v;
 	}
+	clear_shaped_text();
+}
+
+std::string font_manager::shaped_text_key(font const& f, font_selection type, shaping_mode mode, void const* data, size_t size) {
+	// shaping happens at the face's fixed dr_size and is scaled afterwards, so the size is not part of the key
+	// the features, script and language come from the current locale and type, so they are covered by the type
+	// and by clearing the cache on locale change
+	std::string key;
+	key.reserve(sizeof(font const*) + 2 + size);
+	font const* fptr = &f;
+	key.append((char const*)(&fptr), sizeof(font const*));
+	key.push_back(char(type));
+	key.push_back(char(mode));
+	key.append((char const*)data, size);
+	return key;
+}
+
+bool font_manager::find_shaped_text(std::string const& key, stored_glyphs& txt) {
+	auto it = shaped_text_index.find(std::string_view(key));
+	if(it == shaped_text_index.end()) {
+		++shaped_text_misses;
+		return false;
+	}
+	++shaped_text_hits;
+	shaped_text_lru.splice(shaped_text_lru.begin(), shaped_text_lru, it->second);
+	txt.glyph_info = it->second->glyphs;
+	return true;
+}
+
+void font_manager::store_shaped_text(std::string&& key, stored_glyphs const& txt) {
+	if(shaped_text_index.find(std::string_view(key)) != shaped_text_index.end())
+		return;
+	if(shaped_text_lru.size() >= shaped_text_cache_size) {
+		shaped_text_index.erase(std::string_view(shaped_text_lru.back().key));
+		shaped_text_lru.pop_back();
+	}
+	shaped_text_lru.push_front(shaped_text_entry{ std::move(key), txt.glyph_info });
+	shaped_text_index.insert_or_assign(std::string_view(shaped_text_lru.front().key), shaped_text_lru.begin());
+}
+
+void font_manager::clear_shaped_text() {
+	shaped_text_index.clear();
+	shaped_text_lru.clear();
 }
 
 uint16_t make_font_id(sys::state& state, bool as_header, float target_line_size) {
@@ -6,6 +6,8 @@
 #include "hb.h"
 #include "bmfont.hpp"
 #include <span>
+#include <list>
+#include <string>
 
 namespace sys {
 struct state;
@@ -170,6 +172,19 @@ public:
 	}
 };
 
+enum class shaping_mode : uint8_t {
+	utf8,
+	utf16,
+	utf16_no_bidi
+};
+
+struct shaped_text_entry {
+	std::string key;
+	std::vector<stored_glyph> glyphs;
+};
+
+inline constexpr uint32_t shaped_text_cache_size = 4096;
+
 class font_manager {
 public:
 	font_manager();
@@ -181,7 +196,13 @@ public:
 private:
 	std::vector<font> font_array;
 	dcon::locale_id current_locale;
+	// most recently used shaped strings are at the front
+	std::list<shaped_text_entry> shaped_text_lru;
+	ankerl::unordered_dense::map<std::string_view, std::list<shaped_text_entry>::iterator> shaped_text_index;
 public:
+	uint64_t shaped_text_hits = 0;
+	uint64_t shaped_text_misses = 0;
+
 	std::vector<uint8_t> compiled_ubrk_rules;
 	bool map_font_is_black = false;
 
@@ -194,6 +215,15 @@ public:
 	float line_height(sys::state& state, uint16_t font_id);
 	float text_extent(sys::state& state, stored_glyphs const& txt, uint32_t starting_offset, uint32_t count, uint16_t font_id);
 	void set_classic_fonts(bool v);
+
+	static std::string shaped_text_key(font const& f, font_selection type, shaping_mode mode, void const* data, size_t size);
+	bool find_shaped_text(std::string const& key, stored_glyphs& txt);
+	void store_shaped_text(std::string&& key, stored_glyphs const& txt);
+	void clear_shaped_text();
+	float shaped_text_hit_rate() const {
+		auto total = shaped_text_hits + shaped_text_misses;
+		return total != 0 ? float(shaped_text_hits) / float(total) : 0.0f;
+	}
 };
 
 std::string_view classic_unligate_utf8(text::font& font, char32_t c);
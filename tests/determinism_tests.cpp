@@ -3,6 +3,7 @@
 #include "parsers_declarations.hpp"
 #include "dcon_generated.hpp"
 #include "nations.hpp"
+#include "modifiers.hpp"
 #include "container_types.hpp"
 #include "system_state.hpp"
 #include "serialization.hpp"
@@ -302,6 +303,190 @@ TEST_CASE("sim_none", "[determinism]") {
 	compare_game_states(*game_state_1, *game_state_2);
 }
 
+struct connectivity_snapshot {
+	std::vector<uint16_t> regions;
+	std::vector<uint16_t> coasts;
+	std::vector<bool> region_is_coastal;
+	std::vector<std::pair<uint16_t, uint16_t>> adjacent_nations;
+};
+
+// ids are relabelled in province order so that two partitions compare equal regardless of how they were numbered
+connectivity_snapshot take_connectivity_snapshot(sys::state& ws) {
+	connectivity_snapshot result;
+	std::vector<uint16_t> region_labels;
+	std::vector<uint16_t> coast_labels;
+	uint16_t region_count = 0;
+	uint16_t coast_count = 0;
+	auto relabel = [](std::vector<uint16_t>& labels, uint16_t& count, uint16_t id) {
+		if(id == 0)
+			return uint16_t(0);
+		if(labels.size() <= id)
+			labels.resize(id + 1, 0);
+		if(labels[id] == 0)
+			labels[id] = ++count;
+		return labels[id];
+	};
+	for(int32_t i = 0; i < ws.province_definitions.first_sea_province.index(); ++i) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		auto rid = ws.world.province_get_connected_region_id(p);
+		result.regions.push_back(relabel(region_labels, region_count, rid));
+		result.coasts.push_back(relabel(coast_labels, coast_count, ws.world.province_get_connected_coast_id(p)));
+		result.region_is_coastal.push_back(rid != 0 && ws.province_definitions.connected_region_is_coastal[rid - 1]);
+	}
+	ws.world.for_each_nation_adjacency([&](dcon::nation_adjacency_id adj) {
+		auto a = ws.world.nation_adjacency_get_connected_nations(adj, 0).index();
+		auto b = ws.world.nation_adjacency_get_connected_nations(adj, 1).index();
+		result.adjacent_nations.emplace_back(uint16_t(std::min(a, b) + 1), uint16_t(std::max(a, b) + 1));
+	});
+	std::sort(result.adjacent_nations.begin(), result.adjacent_nations.end());
+	return result;
+}
+
+TEST_CASE("connected_regions_incremental", "[determinism]") {
+	// ownership changes are applied incrementally; the result must match a full recompute
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save();
+	auto& ws = *game_state;
+	province::update_connected_regions(ws);
+
+	for(int32_t round = 0; round < 3; ++round) {
+		for(int32_t i = round; i < ws.province_definitions.first_sea_province.index(); i += 13) {
+			dcon::province_id p{ dcon::province_id::value_base_t(i) };
+			auto owner = ws.world.province_get_nation_from_province_ownership(p);
+			if(!owner)
+				continue;
+			// hand the province to a neighbour; this both merges and splits regions
+			for(auto adj : ws.world.province_get_province_adjacency(p)) {
+				auto other = adj.get_connected_provinces(0).id == p ? adj.get_connected_provinces(1) : adj.get_connected_provinces(0);
+				auto other_owner = other.get_nation_from_province_ownership();
+				if(other_owner && other_owner != owner) {
+					province::change_province_owner(ws, p, other_owner);
+					break;
+				}
+			}
+		}
+		REQUIRE(ws.adjacency_data_out_of_date == false);
+		province::update_connected_regions(ws);
+		auto incremental = take_connectivity_snapshot(ws);
+
+		ws.adjacency_data_out_of_date = true;
+		province::update_connected_regions(ws);
+		auto full = take_connectivity_snapshot(ws);
+
+		REQUIRE(incremental.regions == full.regions);
+		REQUIRE(incremental.coasts == full.coasts);
+		REQUIRE(incremental.region_is_coastal == full.region_is_coastal);
+		REQUIRE(incremental.adjacent_nations == full.adjacent_nations);
+	}
+}
+
+TEST_CASE("ui_snapshot_publication", "[determinism]") {
+	// every tick hands the render thread a copy of the top bar values taken after the tick finished
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save();
+	auto& ws = *game_state;
+	for(auto n : ws.world.in_nation) {
+		if(n.get_owned_province_count() != 0) {
+			ws.local_player_nation = n;
+			break;
+		}
+	}
+	REQUIRE(bool(ws.local_player_nation));
+	ws.world.nation_set_is_player_controlled(ws.local_player_nation, true);
+
+	for(int32_t i = 0; i < 3; ++i) {
+		ws.single_game_tick();
+		sys::ui_snapshot latest;
+		bool received = false;
+		auto* snapshot = ws.new_ui_snapshots.front();
+		while(snapshot) {
+			latest = *snapshot;
+			received = true;
+			ws.new_ui_snapshots.pop();
+			snapshot = ws.new_ui_snapshots.front();
+		}
+		REQUIRE(received);
+		REQUIRE(latest.date == ws.current_date);
+		REQUIRE(latest.nation == ws.local_player_nation);
+		REQUIRE(latest.has_records);
+		REQUIRE(latest.treasury == nations::get_treasury(ws, ws.local_player_nation));
+		REQUIRE(latest.population == ws.world.nation_get_demographics(ws.local_player_nation, demographics::total));
+		REQUIRE(latest.infamy == ws.world.nation_get_infamy(ws.local_player_nation));
+	}
+}
+
+static std::vector<float> take_province_modifier_snapshot(sys::state& ws, int32_t first, int32_t last) {
+	std::vector<float> result;
+	for(int32_t i = first; i < last; ++i) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		for(uint32_t j = 0; j < sys::provincial_mod_offsets::count; ++j) {
+			result.push_back(ws.world.province_get_modifier_values(p, dcon::provincial_modifier_value{ dcon::provincial_modifier_value::value_base_t(j) }));
+		}
+	}
+	return result;
+}
+
+static std::vector<float> take_national_modifier_snapshot(sys::state& ws) {
+	std::vector<float> result;
+	for(auto n : ws.world.in_nation) {
+		for(uint32_t j = 0; j < sys::national_mod_offsets::count; ++j) {
+			result.push_back(n.get_modifier_values(dcon::national_modifier_value{ dcon::national_modifier_value::value_base_t(j) }));
+		}
+	}
+	return result;
+}
+
+TEST_CASE("timed_modifiers_incremental", "[determinism]") {
+	// gaining, losing and expiring timed modifiers is applied incrementally; the result must match a full rebuild
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save();
+	auto& ws = *game_state;
+	sys::repopulate_modifier_effects(ws);
+
+	dcon::modifier_id mod;
+	for(auto m : ws.world.in_modifier) {
+		if(m.get_province_values().offsets[0]) {
+			mod = m;
+			break;
+		}
+	}
+	REQUIRE(bool(mod));
+
+	auto const first_sea = ws.province_definitions.first_sea_province.index();
+	auto const province_count = int32_t(ws.world.province_size());
+	auto sea_before = take_province_modifier_snapshot(ws, first_sea, province_count);
+
+	for(int32_t i = 0; i < province_count; i += 7) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		if(i % 3 == 0)
+			sys::add_modifier_to_province(ws, p, mod, sys::date{});
+		else if(i % 3 == 1)
+			sys::add_modifier_to_province(ws, p, mod, ws.current_date + 1);
+		else
+			sys::toggle_modifier_from_province(ws, p, mod, sys::date{});
+	}
+	for(int32_t i = 0; i < province_count; i += 21) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		sys::toggle_modifier_from_province(ws, p, mod, sys::date{});
+	}
+	ws.current_date += 2;
+	sys::update_timed_modifiers(ws);
+
+	auto land_incremental = take_province_modifier_snapshot(ws, 0, first_sea);
+	auto national_incremental = take_national_modifier_snapshot(ws);
+	REQUIRE(take_province_modifier_snapshot(ws, first_sea, province_count) == sea_before);
+
+	sys::repopulate_modifier_effects(ws);
+	auto land_full = take_province_modifier_snapshot(ws, 0, first_sea);
+	auto national_full = take_national_modifier_snapshot(ws);
+
+	REQUIRE(land_incremental.size() == land_full.size());
+	for(size_t i = 0; i < land_full.size(); ++i) {
+		REQUIRE(land_incremental[i] == Approx(land_full[i]).margin(0.001));
+	}
+	REQUIRE(national_incremental.size() == national_full.size());
+	for(size_t i = 0; i < national_full.size(); ++i) {
+		REQUIRE(national_incremental[i] == Approx(national_full[i]).margin(0.001));
+	}
+}
+
 
 
 
@@ -1627,3 +1812,55 @@ TEST_CASE("sim_game_with_saveload_10", "[determinism][sim_with_saveload_tests]")
 	}
 
 }
+
+TEST_CASE("timed_province_modifiers_after_single_nation_update", "[determinism]") {
+	// rebuilding a single nation keeps the national part of its provinces' timed modifiers, which a later removal subtracts
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file_with_save();
+	auto& ws = *game_state;
+	sys::repopulate_modifier_effects(ws);
+
+	dcon::modifier_id mod;
+	for(auto m : ws.world.in_modifier) {
+		if(m.get_national_values().offsets[0]) {
+			mod = m;
+			break;
+		}
+	}
+	REQUIRE(bool(mod));
+
+	dcon::province_id p;
+	dcon::nation_id n;
+	for(auto o : ws.world.in_province_ownership) {
+		bool has_mod = false;
+		for(auto mpr : o.get_province().get_current_modifiers()) {
+			has_mod = has_mod || mpr.mod_id == mod;
+		}
+		if(!has_mod) {
+			p = o.get_province();
+			n = o.get_nation();
+			break;
+		}
+	}
+	REQUIRE(bool(p));
+
+	auto national_values = [&]() {
+		std::vector<float> result;
+		for(uint32_t j = 0; j < sys::national_mod_offsets::count; ++j) {
+			result.push_back(ws.world.nation_get_modifier_values(n, dcon::national_modifier_value{ dcon::national_modifier_value::value_base_t(j) }));
+		}
+		return result;
+	};
+
+	sys::update_single_nation_modifiers(ws, n);
+	auto before = national_values();
+
+	sys::add_modifier_to_province(ws, p, mod, sys::date{});
+	sys::update_single_nation_modifiers(ws, n);
+	sys::remove_modifier_from_province(ws, p, mod);
+	auto after = national_values();
+
+	REQUIRE(after.size() == before.size());
+	for(size_t i = 0; i < before.size(); ++i) {
+		REQUIRE(after[i] == Approx(before[i]).margin(0.001));
+	}
+}
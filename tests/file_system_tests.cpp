@@ -1,5 +1,6 @@
 #include "catch2/catch.hpp"
 #include "simple_fs.hpp"
+#include "serialization.hpp"
 #include <algorithm>
 
 TEST_CASE("File system reading", "[file_system]") {
@@ -130,6 +131,35 @@ TEST_CASE("File system directories", "[file_system]") {
 	}
 }
 
+TEST_CASE("File system lookups", "[file_system]") {
+	simple_fs::file_system fs;
+	add_root(fs, NATIVE_M(PROJECT_ROOT));
+	add_root(fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("tests"));
+
+	auto root_dir = get_root(fs);
+
+	SECTION("nested and case insensitive names") {
+		REQUIRE(bool(peek_file(root_dir, NATIVE("tests/test_main.cpp"))) == true);
+		REQUIRE(bool(open_file(root_dir, NATIVE("cmakelists.txt"))) == true);
+		REQUIRE(bool(peek_file(root_dir, NATIVE("does_not_exist.txt"))) == false);
+	}
+	SECTION("sorted listings") {
+		auto all_files = list_files(root_dir, NATIVE(""));
+		REQUIRE(all_files.size() > size_t(1));
+		for(size_t i = 1; i < all_files.size(); ++i) {
+			auto a = get_file_name(all_files[i - 1]);
+			auto b = get_file_name(all_files[i]);
+			REQUIRE(!std::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end(),
+				[](native_char x, native_char y) { return tolower(x) < tolower(y); }));
+		}
+	}
+	SECTION("roots added later are seen") {
+		REQUIRE(bool(peek_file(root_dir, NATIVE("glew/CMakeLists.txt"))) == false);
+		add_root(fs, NATIVE_M(PROJECT_ROOT) NATIVE_SEP NATIVE("dependencies"));
+		REQUIRE(bool(peek_file(root_dir, NATIVE("glew/CMakeLists.txt"))) == true);
+	}
+}
+
 TEST_CASE("writing special files", "[file_system]") {
 	auto saves_dir = simple_fs::get_or_create_scenario_directory();
 	write_file(saves_dir, NATIVE("fs_test_generated.hpp"), "// nothing to see here", uint32_t(strlen("// nothing to see here")));
@@ -144,4 +174,23 @@ TEST_CASE("writing special files", "[file_system]") {
 	REQUIRE(content.data[2] == ' ');
 	REQUIRE(content.data[3] == 'n');
 	REQUIRE(content.data[4] == 'o');
-}
\ No newline at end of file
+}
+TEST_CASE("content checksums", "[file_system]") {
+	auto dumps_dir = simple_fs::get_or_create_data_dumps_directory();
+	auto checksum_of_dumps = [&]() {
+		simple_fs::file_system fs;
+		add_root(fs, simple_fs::get_full_name(dumps_dir));
+		return sys::compute_content_checksum(fs);
+	};
+
+	write_file(dumps_dir, NATIVE("fs_content_test.txt"), "first", uint32_t(strlen("first")));
+	auto first = checksum_of_dumps();
+	REQUIRE(checksum_of_dumps().is_equal(first));
+
+	write_file(dumps_dir, NATIVE("fs_content_test.txt"), "other", uint32_t(strlen("other")));
+	auto changed = checksum_of_dumps();
+	REQUIRE(!changed.is_equal(first));
+
+	write_file(dumps_dir, NATIVE("fs_content_test.txt"), "first", uint32_t(strlen("first")));
+	REQUIRE(checksum_of_dumps().is_equal(first));
+}
@@ -2,6 +2,8 @@
 #include "system_state.hpp"
 #include "date_interface.hpp"
 #include "cyto_any.hpp"
+#include "triggers.hpp"
+#include "widgets/table.hpp"
 /*
 TEST_CASE("string pool tests", "[misc_tests]") {
 	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
@@ -60,6 +62,73 @@ TEST_CASE("date tests", "[misc_tests]") {
 	REQUIRE(ymdc.day == 16);
 }
 
+TEST_CASE("trigger prefilter tests", "[misc_tests]") {
+	SECTION("conjunction") {
+		std::vector<uint16_t> t;
+		t.push_back(uint16_t(trigger::generic_scope));
+		t.push_back(uint16_t(9));
+		t.push_back(uint16_t(trigger::association_eq | trigger::tag_tag));
+		t.push_back(trigger::payload(dcon::national_identity_id{ 5 }).value);
+		t.push_back(uint16_t(trigger::association_ge | trigger::year));
+		t.push_back(uint16_t(1850));
+		t.push_back(uint16_t(trigger::association_lt | trigger::year));
+		t.push_back(uint16_t(1900));
+		t.push_back(uint16_t(trigger::association_eq | trigger::owns));
+		t.push_back(trigger::payload(dcon::province_id{ 7 }).value);
+
+		sys::trigger_prefilter f;
+		trigger::add_to_prefilter(f, t.data());
+		REQUIRE(f.tag == dcon::national_identity_id{ 5 });
+		REQUIRE(f.owned_province == dcon::province_id{ 7 });
+		REQUIRE(!f.existing_tag);
+		REQUIRE(f.min_year == 1850);
+		REQUIRE(f.max_year == 1899);
+		REQUIRE(trigger::prefilter_limits_candidates(f));
+	}
+	SECTION("negated and disjunctive") {
+		std::vector<uint16_t> t;
+		t.push_back(uint16_t(trigger::generic_scope | trigger::is_disjunctive_scope));
+		t.push_back(uint16_t(5));
+		t.push_back(uint16_t(trigger::association_eq | trigger::tag_tag));
+		t.push_back(trigger::payload(dcon::national_identity_id{ 5 }).value);
+		t.push_back(uint16_t(trigger::association_ge | trigger::year));
+		t.push_back(uint16_t(1850));
+
+		sys::trigger_prefilter f;
+		trigger::add_to_prefilter(f, t.data());
+		REQUIRE(!trigger::prefilter_limits_candidates(f));
+		REQUIRE(f.min_year == std::numeric_limits<int32_t>::min());
+
+		std::vector<uint16_t> u;
+		u.push_back(uint16_t(trigger::association_ne | trigger::tag_tag));
+		u.push_back(trigger::payload(dcon::national_identity_id{ 5 }).value);
+		trigger::add_to_prefilter(f, u.data());
+		REQUIRE(!trigger::prefilter_limits_candidates(f));
+
+		std::vector<uint16_t> v;
+		v.push_back(uint16_t(trigger::association_eq | trigger::exists_tag));
+		v.push_back(trigger::payload(dcon::national_identity_id{ 3 }).value);
+		trigger::add_to_prefilter(f, v.data());
+		REQUIRE(f.existing_tag == dcon::national_identity_id{ 3 });
+	}
+}
+
+TEST_CASE("trigger input tests", "[misc_tests]") {
+	std::vector<uint16_t> t;
+	t.push_back(uint16_t(trigger::generic_scope));
+	t.push_back(uint16_t(5));
+	t.push_back(uint16_t(trigger::association_eq | trigger::technology));
+	t.push_back(trigger::payload(dcon::technology_id{ 2 }).value);
+	t.push_back(uint16_t(trigger::association_eq | trigger::has_country_flag));
+	t.push_back(trigger::payload(dcon::national_flag_id{ 1 }).value);
+	REQUIRE(trigger::read_inputs(t.data()) == (trigger::inputs::technology | trigger::inputs::flags));
+
+	t[1] = uint16_t(7);
+	t.push_back(uint16_t(trigger::association_ge | trigger::year));
+	t.push_back(uint16_t(1850));
+	REQUIRE((trigger::read_inputs(t.data()) & trigger::inputs::untracked) != 0);
+}
+
 TEST_CASE("cyto payload tests", "[misc_tests]") {
 	SECTION("int_emplace") {
 		Cyto::Any payload = int(64);
@@ -225,3 +294,147 @@ TEST_CASE("cyto payload tests", "[misc_tests]") {
 		REQUIRE(any_cast<void *>(vp_payload) == (void *)nullptr);
 	}
 }
+
+TEST_CASE("texture decode tests", "[misc_tests]") {
+	// 2x2 rgba png: red, green / blue, transparent white
+	uint8_t const png[] = {
+		0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+		0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x08, 0x06, 0x00, 0x00, 0x00, 0x72, 0xb6, 0x0d,
+		0x24, 0x00, 0x00, 0x00, 0x13, 0x49, 0x44, 0x41, 0x54, 0x78, 0x9c, 0x63, 0xf8, 0xcf, 0xc0, 0xf0,
+		0x1f, 0x0c, 0x81, 0x34, 0x08, 0x30, 0x00, 0x00, 0x48, 0xc9, 0x08, 0xf8, 0x71, 0xc5, 0x31, 0xe0,
+		0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+	};
+
+	SECTION("decode_png") {
+		auto image = ogl::decode_image(png, sizeof(png));
+		REQUIRE(image.data != nullptr);
+		REQUIRE(image.size_x == 2);
+		REQUIRE(image.size_y == 2);
+		REQUIRE(image.data[0] == 255);
+		REQUIRE(image.data[1] == 0);
+		REQUIRE(image.data[5] == 255);
+		REQUIRE(image.data[10] == 255);
+		REQUIRE(image.data[15] == 0);
+
+		auto moved = std::move(image);
+		REQUIRE(image.data == nullptr);
+		REQUIRE(moved.data != nullptr);
+	}
+	SECTION("decode_garbage") {
+		uint8_t const garbage[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+		auto image = ogl::decode_image(garbage, sizeof(garbage));
+		REQUIRE(image.data == nullptr);
+		REQUIRE(image.size_x == 0);
+	}
+	SECTION("decoder_missing_files") {
+		simple_fs::file_system fs;
+		add_root(fs, NATIVE("."));
+		ogl::texture_decoder decoder;
+		decoder.request(fs, ogl::texture_decode_request{ dcon::texture_id{ 3 }, { NATIVE("no_such_flag.png"), NATIVE("no_such_flag.tga") } });
+
+		ogl::texture_decode_result result;
+		while(!decoder.pop_result(result)) {
+			std::this_thread::yield();
+		}
+		REQUIRE(result.id == dcon::texture_id{ 3 });
+		REQUIRE(result.image.data == nullptr);
+	}
+}
+
+TEST_CASE("ui batch tests", "[misc_tests]") {
+	float const square[] = {
+		0.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 1.0f,
+		1.0f, 1.0f, 1.0f, 1.0f,
+		1.0f, 0.0f, 1.0f, 0.0f
+	};
+	ogl::ui_batch_key a;
+	a.texture = 1;
+	a.filter = ogl::parameters::no_filter;
+	ogl::ui_batch_key b = a;
+	b.texture = 2;
+
+	SECTION("merge_disjoint") {
+		ogl::ui_batch batch;
+		batch.record(a, 0.0f, 0.0f, 10.0f, 10.0f, square);
+		batch.record(b, 20.0f, 0.0f, 10.0f, 10.0f, square);
+		batch.record(a, 40.0f, 0.0f, 10.0f, 10.0f, square);
+		REQUIRE(batch.runs.size() == 2);
+
+		batch.build();
+		REQUIRE(batch.vertices.size() == 18);
+		REQUIRE(batch.runs[0].first == 0);
+		REQUIRE(batch.runs[0].count == 12);
+		REQUIRE(batch.runs[1].first == 12);
+		REQUIRE(batch.runs[1].count == 6);
+		// the third quad is drawn right after the first
+		REQUIRE(batch.vertices[6].x == 40.0f);
+		REQUIRE(batch.vertices[8].x == 50.0f);
+		REQUIRE(batch.vertices[8].y == 10.0f);
+		REQUIRE(batch.vertices[8].u == 1.0f);
+		REQUIRE(batch.vertices[12].x == 20.0f);
+	}
+	SECTION("keep_overlapping_order") {
+		ogl::ui_batch batch;
+		batch.record(a, 0.0f, 0.0f, 10.0f, 10.0f, square);
+		batch.record(b, 5.0f, 5.0f, 10.0f, 10.0f, square);
+		batch.record(a, 8.0f, 8.0f, 10.0f, 10.0f, square);
+		REQUIRE(batch.runs.size() == 3);
+
+		batch.build();
+		REQUIRE(batch.vertices.size() == 18);
+		REQUIRE(batch.runs[2].first == 12);
+		REQUIRE(batch.vertices[12].x == 8.0f);
+
+		batch.clear();
+		REQUIRE(batch.empty());
+		REQUIRE(batch.runs.empty());
+	}
+}
+
+TEST_CASE("incremental table order tests", "[misc_tests]") {
+	std::vector<int32_t> rows = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+	std::vector<float> values = { 5.0f, 3.0f, 5.0f, 1.0f, 9.0f, 7.0f, 3.0f, 8.0f, 2.0f, 6.0f };
+
+	auto full_sort = [&]() {
+		std::vector<uint32_t> expected(rows.size());
+		for(uint32_t i = 0; i < uint32_t(expected.size()); ++i)
+			expected[i] = i;
+		std::stable_sort(expected.begin(), expected.end(), [&](uint32_t a, uint32_t b) { return values[a] < values[b]; });
+		return expected;
+	};
+
+	::table::incremental_order<int32_t, float> order;
+	SECTION("first_update_sorts_everything") {
+		auto result = order.update(rows, std::vector<float>(values));
+		REQUIRE(result == full_sort());
+		REQUIRE(order.last_sorted_count == 10);
+	}
+	SECTION("only_changed_keys_are_sorted") {
+		order.update(rows, std::vector<float>(values));
+		values[4] = 0.0f;
+		values[6] = 5.0f;
+		auto result = order.update(rows, std::vector<float>(values));
+		REQUIRE(result == full_sort());
+		REQUIRE(order.last_sorted_count == 2);
+
+		result = order.update(rows, std::vector<float>(values));
+		REQUIRE(result == full_sort());
+		REQUIRE(order.last_sorted_count == 0);
+	}
+	SECTION("new_rows_sort_everything") {
+		order.update(rows, std::vector<float>(values));
+		rows.push_back(20);
+		values.push_back(4.0f);
+		auto result = order.update(rows, std::vector<float>(values));
+		REQUIRE(result == full_sort());
+		REQUIRE(order.last_sorted_count == 11);
+	}
+	SECTION("names_rank_in_order") {
+		auto ranks = ::table::rank_names({ "b", "a", "c", "a" });
+		REQUIRE(ranks[0] == 1.0f);
+		REQUIRE(ranks[1] == 0.0f);
+		REQUIRE(ranks[2] == 2.0f);
+		REQUIRE(ranks[3] == 0.0f);
+	}
+}
@@ -1,6 +1,7 @@
 #include "catch2/catch.hpp"
 #include "parsers.hpp"
 #include <cstring>
+#include <random>
 
 struct basic_object_a {
 	int32_t int_value = 0;
@@ -504,3 +505,102 @@ TEST_CASE("Floating point parser tests", "[parsers]") {
 		REQUIRE(val == -1.5);
 	}
 }
+
+// per-character copy of the tokenizer, used as the reference for the block scanning version
+struct reference_tokenizer {
+	char const *position = nullptr;
+	char const *file_end = nullptr;
+	int32_t current_line = 1;
+
+	static bool ignorable(char c) {
+		return c == ' ' || c == '\r' || c == '\f' || c == '\n' || c == '\t' || c == ',' || c == ';';
+	}
+	static bool breaking(char c) {
+		return ignorable(c) || c == '{' || c == '}' || c == '!' || c == '=' || c == '<' || c == '>' || c == '#';
+	}
+	template<typename T>
+	char const *skip_while(char const *p, T &&condition) {
+		while (p < file_end && condition(*p)) {
+			if (*p == '\n')
+				++current_line;
+			++p;
+		}
+		return p;
+	}
+	char const *skip_non_comment(char const *p) {
+		p = skip_while(p, ignorable);
+		while (p < file_end && *p == '#') {
+			p = skip_while(p, [](char c) { return c != '\r' && c != '\n'; });
+			p = skip_while(p, [](char c) { return c == '\r' || c == '\n'; });
+			p = skip_while(p, ignorable);
+		}
+		return p;
+	}
+	parsers::token_and_type next() {
+		if (position >= file_end)
+			return parsers::token_and_type{std::string_view(), current_line, parsers::token_type::unknown};
+		auto non_ws = skip_non_comment(position);
+		if (non_ws >= file_end) {
+			position = file_end;
+			return parsers::token_and_type{std::string_view(), current_line, parsers::token_type::unknown};
+		}
+		auto const two = [&](char const *s) { return non_ws + 1 < file_end && non_ws[0] == s[0] && non_ws[1] == s[1]; };
+		if (*non_ws == '{' || *non_ws == '}') {
+			position = non_ws + 1;
+			return parsers::token_and_type{std::string_view(non_ws, 1), current_line,
+			                               *non_ws == '{' ? parsers::token_type::open_brace : parsers::token_type::close_brace};
+		} else if (*non_ws == '\"' || *non_ws == '\'') {
+			char const q = *non_ws;
+			auto const close = skip_while(non_ws + 1, [q](char c) { return c != '\r' && c != '\n' && c != q; });
+			position = close + 1;
+			return parsers::token_and_type{std::string_view(non_ws + 1, close - (non_ws + 1)), current_line, parsers::token_type::quoted_string};
+		} else if (two("==") || two("<=") || two(">=") || two("<>") || two("!=")) {
+			position = non_ws + 2;
+			return parsers::token_and_type{std::string_view(non_ws, 2), current_line, parsers::token_type::special_identifier};
+		} else if (*non_ws == '<' || *non_ws == '>' || *non_ws == '=') {
+			position = non_ws + 1;
+			return parsers::token_and_type{std::string_view(non_ws, 1), current_line, parsers::token_type::special_identifier};
+		} else {
+			position = skip_while(non_ws + 1, [](char c) { return !breaking(c); });
+			return parsers::token_and_type{std::string_view(non_ws, position - non_ws), current_line, parsers::token_type::identifier};
+		}
+	}
+};
+
+TEST_CASE("Tokenizer matches per-character scanning", "[parsers]") {
+	auto compare_tokens = [](std::string const &text) {
+		parsers::token_generator gen(text.data(), text.data() + text.size());
+		reference_tokenizer ref{text.data(), text.data() + text.size()};
+		while (true) {
+			auto const a = gen.get();
+			auto const b = ref.next();
+			REQUIRE(a.type == b.type);
+			REQUIRE(a.line == b.line);
+			REQUIRE(a.content.data() == b.content.data());
+			REQUIRE(a.content.size() == b.content.size());
+			if (a.type == parsers::token_type::unknown)
+				break;
+		}
+	};
+	SECTION("long runs cross block boundaries") {
+		compare_tokens("a_very_long_identifier_that_spans_more_than_one_block_of_characters = { x = 1 }\n"
+		               "# a comment that is also long enough to need more than a single block of scanning\r\n"
+		               "\n\n\n\t\t\t                                                        , ; ,; key = \"a quoted string with "
+		               "enough text to cross at least one block\"\nother = 'single quoted' last >= 2 <> 3 != 4");
+	}
+	SECTION("random inputs") {
+		static char const alphabet[] = "abcXYZ019_.-  \t\n\n\r\f,;{}!=<>#\"'";
+		std::mt19937 rng(12345);
+		std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+		std::uniform_int_distribution<int32_t> run(1, 40);
+		for (int32_t i = 0; i < 2000; ++i) {
+			std::string text;
+			auto const pieces = run(rng);
+			for (int32_t j = 0; j < pieces; ++j) {
+				// repeat characters so that whitespace, comments and identifiers form long runs
+				text.append(size_t(run(rng)), alphabet[pick(rng)]);
+			}
+			compare_tokens(text);
+		}
+	}
+}
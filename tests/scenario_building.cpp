@@ -1368,7 +1368,7 @@ TEST_CASE("Scenario building", "[req-game-files]") {
 
 	// Obtain filesystem state just before saving (see test below)
 	const auto fs_str = simple_fs::extract_state(state->common_fs);
-	sys::write_scenario_file(*state, NATIVE("sb_test_file.bin"), 1);
+	sys::write_scenario_file(*state, NATIVE("sb_test_file.bin"), 1, sys::compute_content_checksum(state->common_fs));
 
 	state = nullptr;
 	state = std::make_unique<sys::state>();
@@ -54,8 +54,9 @@ std::unique_ptr<sys::state> load_testing_scenario_file_with_save(sys::network_mo
 	if(!sys::try_read_scenario_and_save_file(*game_state, NATIVE("tests_scenario.bin"))) {
 		// scenario making functions
 		parsers::error_handler err("");
+		auto content_key = sys::compute_content_checksum(game_state->common_fs);
 		game_state->load_scenario_data(err, sys::year_month_day{ 1836, 1, 1 });
-		sys::write_scenario_file(*game_state, NATIVE("tests_scenario.bin"), 1);
+		sys::write_scenario_file(*game_state, NATIVE("tests_scenario.bin"), 1, content_key);
 		INFO("Wrote new scenario");
 		std::abort();
 	} else {